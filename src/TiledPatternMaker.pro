@@ -161,14 +161,17 @@ SOURCES += \
     model/motifs/irregular_tools.cpp \
     model/motifs/motif.cpp \
     model/motifs/motif_connector.cpp \
+    model/motifs/motif_map_cache.cpp \
     model/motifs/radial_motif.cpp \
     model/motifs/radial_ray.cpp \
     model/motifs/rosette.cpp \
     model/motifs/rosette2.cpp \
     model/motifs/star.cpp \
     model/motifs/star2.cpp \
+    model/motifs/tile_mid_index.cpp \
     model/motifs/tile_motif.cpp \
     model/prototypes/design_element.cpp \
+    model/prototypes/proto_map_cache.cpp \
     model/prototypes/prototype.cpp \
     model/settings/canvas.cpp \
     model/settings/canvas_settings.cpp \
@@ -230,6 +233,7 @@ SOURCES += \
     sys/enums/edgetype.cpp \
     sys/enums/efillmode.cpp \
     sys/enums/efilltype.cpp \
+    sys/enums/einvalidate.cpp \
     sys/enums/emapeditor.cpp \
     sys/enums/emotiftype.cpp \
     sys/enums/epanelpage.cpp \
@@ -242,14 +246,19 @@ SOURCES += \
     sys/geometry/crop.cpp \
     sys/geometry/dcel.cpp \
     sys/geometry/debug_map.cpp \
+    sys/geometry/draw_index.cpp \
     sys/geometry/edge.cpp \
+    sys/geometry/edge_index.cpp \
     sys/geometry/edge_poly.cpp \
+    sys/geometry/face_index.cpp \
     sys/geometry/faces.cpp \
     sys/geometry/fill_region.cpp \
+    sys/geometry/flat_map.cpp \
     sys/geometry/geo.cpp \
     sys/geometry/intersect.cpp \
     sys/geometry/loose.cpp \
     sys/geometry/map.cpp \
+    sys/geometry/map_arena.cpp \
     sys/geometry/map_base.cpp \
     sys/geometry/map_cleanser.cpp \
     sys/geometry/map_verifier.cpp \
@@ -260,6 +269,7 @@ SOURCES += \
     sys/geometry/threads.cpp \
     sys/geometry/transform.cpp \
     sys/geometry/vertex.cpp \
+    sys/geometry/vertex_index.cpp \
     sys/geometry/xform.cpp \
     sys/main.cpp \
     sys/qt/qtapplog.cpp \
@@ -267,6 +277,7 @@ SOURCES += \
     sys/qt/utilities.cpp \
     sys/sys/debugflags.cpp \
     sys/sys/fileservices.cpp \
+    sys/sys/invalidator.cpp \
     sys/sys/load_unit.cpp \
     sys/sys/pugixml.cpp \
     sys/sys/versioning.cpp \
@@ -424,6 +435,7 @@ HEADERS += \
     model/motifs/irregular_tools.h \
     model/motifs/motif.h \
     model/motifs/motif_connector.h \
+    model/motifs/motif_map_cache.h \
     model/motifs/radial_motif.h \
     model/motifs/radial_ray.h \
     model/motifs/rosette.h \
@@ -431,8 +443,10 @@ HEADERS += \
     model/motifs/star.h \
     model/motifs/star2.h \
     model/motifs/tile_color_defs.h \
+    model/motifs/tile_mid_index.h \
     model/motifs/tile_motif.h \
     model/prototypes/design_element.h \
+    model/prototypes/proto_map_cache.h \
     model/prototypes/prototype.h \
     model/settings/canvas.h \
     model/settings/canvas_settings.h \
@@ -498,12 +512,12 @@ HEADERS += \
     sys/enums/efilesystem.h \
     sys/enums/efillmode.h \
     sys/enums/efilltype.h \
+    sys/enums/einvalidate.h \
     sys/enums/elogmode.h \
     sys/enums/emapeditor.h \
     sys/enums/emotiftype.h \
     sys/enums/emousemode.h \
     sys/enums/epanelpage.h \
-    sys/enums/erender.h \
     sys/enums/estatemachineevent.h \
     sys/enums/estyletype.h \
     sys/enums/etilingmaker.h \
@@ -514,14 +528,19 @@ HEADERS += \
     sys/geometry/crop.h \
     sys/geometry/dcel.h \
     sys/geometry/debug_map.h \
+    sys/geometry/draw_index.h \
     sys/geometry/edge.h \
+    sys/geometry/edge_index.h \
     sys/geometry/edge_poly.h \
+    sys/geometry/face_index.h \
     sys/geometry/faces.h \
     sys/geometry/fill_region.h \
+    sys/geometry/flat_map.h \
     sys/geometry/geo.h \
     sys/geometry/intersect.h \
     sys/geometry/loose.h \
     sys/geometry/map.h \
+    sys/geometry/map_arena.h \
     sys/geometry/map_base.h \
     sys/geometry/map_cleanser.h \
     sys/geometry/map_verifier.h \
@@ -532,14 +551,17 @@ HEADERS += \
     sys/geometry/threads.h \
     sys/geometry/transform.h \
     sys/geometry/vertex.h \
+    sys/geometry/vertex_index.h \
     sys/geometry/xform.h \
     sys/qt/qtapplog.h \
     sys/qt/timers.h \
     sys/qt/tpm_io.h \
+    sys/qt/unique_hash_qvector.h \
     sys/qt/unique_qvector.h \
     sys/qt/utilities.h \
     sys/sys/debugflags.h \
     sys/sys/fileservices.h \
+    sys/sys/invalidator.h \
     sys/sys/load_unit.h \
     sys/sys/pugiconfig.hpp \
     sys/sys/pugixml.hpp \
@@ -46,7 +46,6 @@ void MapEditor::init()
 
     unload();
 
-    connect(this, &MapEditor::sig_updateView, Sys::viewController, &SystemViewController::slot_updateView);
     connect(this, &MapEditor::sig_raiseMenu,  Sys::controlPanel,   &ControlPanel::slot_raisePanel);
 }
 
@@ -422,7 +421,7 @@ bool MapEditor::pushToMosaic(MapEditorLayer & layer)
         }
     }
 
-    //Sys::render(RENDER_RESET_STYLES);
+    //Sys::invalidate(INV_STYLE);
     emit sig_styleMapUpdated(map);
 
     return true;
@@ -602,7 +601,7 @@ bool MapEditor::loadTemplate(VersionedFile xfile, bool animate)
         if (!timer)
         {
             timer = new QTimer(this);
-            connect(timer, &QTimer::timeout, this, [this] { _stash.nextAnimationStep(db,timer); emit sig_updateView(); } );
+            connect(timer, &QTimer::timeout, this, [this] { _stash.nextAnimationStep(db,timer); forceRedraw(); } );
         }
         timer->start(500);
     }
@@ -642,11 +641,13 @@ bool MapEditor::initStashFrom(VersionedName mosaicname)
     return rv;
 }
 
+// Edits only change what the editor layer draws, so only that layer is
+// repainted, and the other layers keep their cached images
 void MapEditor::forceRedraw()
 {
     if (Sys::viewController->isEnabled(VIEW_MAP_EDITOR))
     {
-        emit sig_updateView();
+        Sys::mapEditorView->forceRedraw();
     }
 }
 
@@ -75,7 +75,6 @@ public:
 
 signals:
     void    sig_close();
-    void    sig_updateView();
     void    sig_raiseMenu();
     void    sig_styleMapUpdated(MapPtr map);
 
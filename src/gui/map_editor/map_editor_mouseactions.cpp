@@ -28,14 +28,13 @@ MapMouseAction::MapMouseAction(QPointF spt)
     db        = Sys::mapEditorView->getDb();
     last_drag = spt;
 
-    connect(this, &MapMouseAction::sig_updateView, Sys::viewController, &SystemViewController::slot_updateView);
-
     forceRedraw();
 }
 
+// a drag only moves what the editor layer draws
 void MapMouseAction::forceRedraw()
 {
-    emit sig_updateView();
+    Sys::mapEditorView->forceRedraw();
 }
 
 void MapMouseAction::updateDragging(QPointF spt)
@@ -125,6 +124,7 @@ void MoveVertex::endDragging( QPointF spt)
                 Q_ASSERT(ep->v2 == _vp);
                 ep->setV2(existing);    // substitue
             }
+            map->touch(ep);
         }
         map->removeVertexSimple(_vp);   // delete
         qDebug() << "SNAPTO vertex";
@@ -166,6 +166,9 @@ void MoveVertex::endDragging( QPointF spt)
         }
     }
 
+    map->resetNeighbourMap();   // the vertex has moved
+    map->touch(_vp);
+
 	// tidy up
     MapCleanser mc(map);
     mc.cleanse(joinupColinearEdges | divideupIntersectingEdges,Sys::config->mapedMergeSensitivity);   // deal with lines crossing existing lines
@@ -216,6 +219,8 @@ void MoveEdge::endDragging(QPointF spt)
     MapPtr map = db->getEditMap();
     if (map)
     {
+        map->resetNeighbourMap();   // the edge has moved
+        map->touch(_edge);
         MapCleanser mc(map);
         mc.cleanse(divideupIntersectingEdges,Sys::config->mapedMergeSensitivity);     // deal with lines crossing existing lines
         MapMouseAction::endDragging(spt);
@@ -40,9 +40,6 @@ public:
 
     QString desc;
 
-signals:
-    void    sig_updateView();
-
 protected:
     void    forceRedraw();
 
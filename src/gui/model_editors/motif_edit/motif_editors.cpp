@@ -202,6 +202,7 @@ void NamedMotifEditor::slot_motifModified(MotifPtr motif)
     ProtoEvent pevent;
     pevent.event = PROM_MOTIF_CHANGED;
     pevent.tiling = tiling;
+    pevent.tile   = del->getTile();
     Sys::prototypeMaker->sm_takeUp(pevent);
     
     //data->select(MVD_DELEM,del,multi);
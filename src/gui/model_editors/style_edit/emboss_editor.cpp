@@ -2,6 +2,7 @@
 #include "gui/widgets/panel_misc.h"
 #include "gui/widgets/layout_sliderset.h"
 #include "model/styles/emboss.h"
+#include "sys/sys.h"
 
 #define ROW_HEIGHT 39
 
@@ -80,8 +81,6 @@ void EmbossEditor::slot_anlgeChanged(int angle)
 
     qDebug() << "angle=" << angle;
     emboss->setAngle( angle * M_PI / 180.0 );
-    emboss->resetStyleRepresentation();
-    emboss->createStyleRepresentation();
-    emit sig_updateView();
+    Sys::invalidate(emboss);
 }
 
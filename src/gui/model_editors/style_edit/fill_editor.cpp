@@ -148,11 +148,10 @@ void FilledEditor::slot_algo(eFillType algo)
     eFillType old = filled->getAlgorithm();
     filled->setAlgorithm(algo);
     filled->initAlgorithmFrom(old);         // signals a change
-    filled->resetStyleRepresentation();
 
     createSubTypeEditor(algo);
 
-    emit sig_reconstructView();
+    Sys::invalidate(filled);
 }
 
 void FilledEditor::slot_colorsChanged()
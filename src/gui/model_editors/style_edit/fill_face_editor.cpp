@@ -5,6 +5,8 @@
 #include "gui/model_editors/style_edit/style_editor.h"
 #include "gui/widgets/panel_misc.h"
 #include "gui/widgets/dlg_colorSet.h"
+#include "model/styles/filled.h"
+#include "sys/sys.h"
 
 FillFaceEditor::FillFaceEditor(FilledEditor * parent, FilledPtr style, DirectColoring *cm, QVBoxLayout * vbox)
     : FilledSubTypeEditor(parent,style,cm)
@@ -156,9 +158,7 @@ void FillFaceEditor::slot_resetColorMap()
     auto filled = wfilled.lock();
     if (filled)
     {
-        filled->resetStyleRepresentation();     // erases the color map
-        filled->createStyleRepresentation();
-        emit sig_updateView();
+        Sys::invalidate(filled);     // erases the color map
     }
 }
 
@@ -8,6 +8,8 @@
 #include "gui/widgets/dlg_colorSet.h"
 #include "gui/widgets/panel_misc.h"
 #include "model/styles/colorset.h"
+#include "model/styles/filled.h"
+#include "sys/sys.h"
 
 FillGroupEditor::FillGroupEditor(FilledEditor *parent, FilledPtr style, New3Coloring * cm, QVBoxLayout *vbox)
     : FilledSubTypeEditor(parent,style,cm)
@@ -284,9 +286,8 @@ void FillGroupEditor::notify()
     // colors immediately.
     if (auto filled = parent->getFilled())
     {
-        filled->resetStyleRepresentation();
+        Sys::invalidate(filled);
     }
-    emit parent->sig_reconstructView();
 }
 
 
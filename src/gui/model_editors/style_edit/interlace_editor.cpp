@@ -2,6 +2,7 @@
 #include "gui/widgets/panel_misc.h"
 #include "gui/widgets/layout_sliderset.h"
 #include "model/styles/interlace.h"
+#include "sys/sys.h"
 
 #define ROW_HEIGHT 39
 
@@ -89,9 +90,7 @@ void InterlaceEditor::slot_gapChanged(qreal gap)
     if (!interlace) return;
 
     interlace->setGap(gap);
-    interlace->resetStyleRepresentation();
-    interlace->createStyleRepresentation();
-    emit sig_updateView();
+    Sys::invalidate(interlace);
 }
 
 void InterlaceEditor::slot_shadowChanged(qreal shadow)
@@ -100,9 +99,7 @@ void InterlaceEditor::slot_shadowChanged(qreal shadow)
     if (!interlace) return;
 
     interlace->setShadow(shadow);
-    interlace->resetStyleRepresentation();
-    interlace->createStyleRepresentation();
-    emit sig_updateView();
+    Sys::invalidate(interlace);
 }
 
 void InterlaceEditor::slot_startUnderChanged(bool checked)
@@ -111,9 +108,7 @@ void InterlaceEditor::slot_startUnderChanged(bool checked)
     if (!interlace) return;
 
     interlace->setInitialStartUnder(checked);
-    interlace->resetStyleRepresentation();
-    interlace->createStyleRepresentation();
-    emit sig_updateView();
+    Sys::invalidate(interlace);
 }
 
 void InterlaceEditor::slot_includeTipVerticesChanged(bool checked)
@@ -122,8 +117,6 @@ void InterlaceEditor::slot_includeTipVerticesChanged(bool checked)
     if (!interlace) return;
 
     interlace->setIncludeTipVertices(checked);
-    interlace->resetStyleRepresentation();
-    interlace->createStyleRepresentation();
-    emit sig_updateView();
+    Sys::invalidate(interlace);
 }
 
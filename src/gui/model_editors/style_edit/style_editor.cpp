@@ -1,6 +1,7 @@
 #include "gui/model_editors/style_edit/style_editor.h"
 #include "gui/model_editors/style_edit/fill_editor.h"
 #include "model/styles/style.h"
+#include "sys/sys.h"
 
 StyleEditor::StyleEditor(StylePtr style, eStyleType user) : QWidget()
 {
@@ -31,8 +32,7 @@ void StyleEditor::notify()
     case STYLE_OUTLINED:
     case STYLE_TILECOLORS:
         if (auto style = wStyle.lock())
-            style->resetStyleRepresentation();
-        emit sig_reconstructView();
+            Sys::invalidate(style);     // recreated on the next flush
         break;
 
         // overloaded
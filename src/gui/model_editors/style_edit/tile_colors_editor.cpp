@@ -229,8 +229,7 @@ void  TileColorsEditor::slot_colors_changed()
     auto tileColors = wtilecolors.lock();
     if (!tileColors) return;
 
-    tileColors->resetStyleRepresentation();     // need to calc _colorSets and _coloredPlacements
-    emit sig_reconstructView();
+    Sys::invalidate(tileColors);     // need to calc _colorSets and _coloredPlacements
 }
 
 void TileColorsEditor::slot_outlineChanged(bool checked)
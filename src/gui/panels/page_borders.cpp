@@ -19,6 +19,7 @@
 #include "model/styles/style.h"
 #include "sys/enums/eborder.h"
 #include "sys/geometry/crop.h"
+#include "sys/sys.h"
 
 using std::string;
 using std::make_shared;
@@ -561,9 +562,7 @@ void page_borders::slot_loadFromCrop()
         break;
     }
 
-    border->resetStyleRepresentation();
-
-    emit sig_reconstructView();
+    Sys::invalidate(INV_BORDER);
 
     QMessageBox box(panel);
     box.setIcon(QMessageBox::Information);
@@ -647,9 +646,7 @@ void page_borders::slot_loadFromPainterCrop()
         break;
     }
 
-    border->resetStyleRepresentation();
-
-    emit sig_reconstructView();
+    Sys::invalidate(INV_BORDER);
 
     QMessageBox box(panel);
     box.setIcon(QMessageBox::Information);
@@ -11,6 +11,7 @@
 #include "model/mosaics/mosaic.h"
 #include "model/prototypes/prototype.h"
 #include "sys/geometry/crop.h"
+#include "sys/sys.h"
 
 using std::string;
 using std::make_shared;
@@ -269,7 +270,7 @@ void page_crop_maker::slot_applyCrop()
     if (crop)
     {
         mosaicMaker->getMosaic()->setCrop(crop);
-        emit sig_reconstructView();
+        Sys::invalidate(INV_CROP);
     }
     else
     {
@@ -284,7 +285,7 @@ void page_crop_maker::slot_applyCrop()
 void page_crop_maker::slot_removeMosaicCrop()
 {
     mosaicCropMaker.removeCrop();
-    emit sig_reconstructView();
+    Sys::invalidate(INV_CROP);
 }
 
 void page_crop_maker::slot_removePainterCrop()
@@ -331,7 +332,7 @@ void page_crop_maker::slot_fetchBorder()
     crop->setRect(r);
 
     //crop->transform(Sys::cropViewer->getLayerTransform().inverted());
-    emit sig_reconstructView();
+    Sys::invalidate(INV_CROP);      // the rect has changed since setCrop
 
     QMessageBox box(panel);
     box.setIcon(QMessageBox::Information);
@@ -1,6 +1,10 @@
 #include <QGroupBox>
 #include <QCheckBox>
 #include <QMessageBox>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QRandomGenerator>
+#include <QtMath>
 
 #include "gui/map_editor/map_editor.h"
 #include "gui/panels/page_debug.h"
@@ -16,6 +20,10 @@
 #include "model/mosaics/mosaic.h"
 #include "model/mosaics/mosaic_manager.h"
 #include "model/mosaics/mosaic_reader.h"
+#include "model/motifs/motif_map_cache.h"
+#include "model/motifs/rosette.h"
+#include "model/motifs/star.h"
+#include "model/prototypes/proto_map_cache.h"
 #include "model/prototypes/prototype.h"
 #include "model/settings/configuration.h"
 #include "model/styles/filled.h"
@@ -23,9 +31,15 @@
 #include "model/tilings/tile.h"
 #include "model/tilings/tiling.h"
 #include "model/tilings/tiling_manager.h"
+#include "sys/geometry/edge.h"
 #include "sys/geometry/map.h"
+#include "sys/geometry/map_cleanser.h"
 #include "sys/geometry/map_verifier.h"
+#include "sys/geometry/vertex.h"
 #include "sys/qt/qtapplog.h"
+#include "sys/qt/unique_hash_qvector.h"
+#include "sys/qt/unique_qvector.h"
+#include "sys/sys.h"
 #include "sys/sys/debugflags.h"
 #include "sys/sys/fileservices.h"
 
@@ -163,8 +177,10 @@ QGroupBox * page_debug::createDebugSettings()
     QCheckBox   * chkDontTrap           = new QCheckBox("Don't Trap Log");
     QCheckBox   * chkLayerCen           = new QCheckBox("Show Layer Centre");
     QCheckBox   * chkEnbLog2            = new QCheckBox("Enable LOG2");
+    QCheckBox   * chkLayerCache         = new QCheckBox("Cache Layer Images");
 
     chkEnbLog2->setChecked(Sys::config->enableLog2);
+    chkLayerCache->setChecked(Sys::config->layerImageCache);
     chkDontRefresh->setChecked(!Sys::updatePanel);
 
     QVBoxLayout * vbox = new QVBoxLayout;
@@ -173,6 +189,7 @@ QGroupBox * page_debug::createDebugSettings()
     vbox->addWidget(chkDontTrap);
     vbox->addWidget(chkLayerCen);
     vbox->addWidget(chkEnbLog2);
+    vbox->addWidget(chkLayerCache);
 
     QGroupBox * debugGroup = new QGroupBox("Debug Settings");
     debugGroup->setLayout(vbox);
@@ -181,7 +198,7 @@ QGroupBox * page_debug::createDebugSettings()
     connect(chkDontTrap,              &QCheckBox::clicked,       this,   &page_debug::slot_dontTrapLog);
     connect(chkDontRefresh,           &QCheckBox::clicked,       this,   &page_debug::slot_dontRefresh);
     connect(chkLayerCen,              &QCheckBox::clicked,       this,   &page_debug::slot_viewViewCen);
-    connect(chkEnbLog2,               &QCheckBox::clicked,       this,   [](bool enb) { Sys::config->enableLog2 = enb; } );
+    connect(chkLayerCache,            &QCheckBox::clicked,       this,   [](bool enb) { Sys::config->layerImageCache = enb; Sys::viewController->slot_updateView(); } );
     connect(chkEnbLog2,               &QCheckBox::clicked,       this,   [](bool enb) { Sys::config->enableLog2 = enb; } );
 
     return debugGroup;
@@ -207,6 +224,10 @@ QGroupBox * page_debug::createDebugTests()
 
     QPushButton * pbClearMakers         = new QPushButton("Clear Makers");
     QPushButton * pbClearView           = new QPushButton("Clear View");
+    QPushButton * pbBenchContainers     = new QPushButton("Benchmark Containers");
+    QPushButton * pbBenchCoalesce       = new QPushButton("Benchmark Coalesce");
+    QPushButton * pbTestRadial          = new QPushButton("Test Radial Replication");
+    QPushButton * pbClearProtoCache     = new QPushButton("Clear Proto Cache");
 
     AQPushButton* pbPick                = new AQPushButton("Color Picker");
                   colorTxt              = new QLabel();
@@ -233,6 +254,10 @@ QGroupBox * page_debug::createDebugTests()
     grid->addWidget(pbClearMakers,         0,1);
     grid->addWidget(pbClearView,           1,1);
     grid->addWidget(pbReformatTemplates,   2,1);
+    grid->addWidget(pbBenchContainers,     3,1);
+    grid->addWidget(pbClearProtoCache,     4,1);
+    grid->addWidget(pbBenchCoalesce,       6,1);
+    grid->addWidget(pbTestRadial,          7,1);
 
     // GENERIC
     grid->addWidget(pTestA,                0,0);
@@ -254,6 +279,10 @@ QGroupBox * page_debug::createDebugTests()
     connect(pbReformatTileXMLBtn,     &QPushButton::clicked,     this,   [this] { reformatTilingXML(); });
     connect(pbReprocessTileXMLBtn,    &QPushButton::clicked,     this,   [this] { reprocessTilingXML(); });
     connect(pbReformatTemplates,      &QPushButton::clicked,     this,   [this] { reformatOldTemplates(); });
+    connect(pbBenchContainers,        &QPushButton::clicked,     this,   [this] { benchmarkContainers(); });
+    connect(pbBenchCoalesce,          &QPushButton::clicked,     this,   [this] { benchmarkCoalesce(); });
+    connect(pbTestRadial,             &QPushButton::clicked,     this,   [this] { testRadialReplication(); });
+    connect(pbClearProtoCache,        &QPushButton::clicked,     this,   [] { ProtoMapCache::clear(); MotifMapCache::clear(); });
 
     connect(pbVerifyTileNames,        &QPushButton::clicked,     this,   [this] { verifyTilingNames(); });
     connect(pbVerifyTiling,           &QPushButton::clicked,     this,   [this] { verifyTiling(); });
@@ -362,13 +391,57 @@ QGroupBox * page_debug::createCleanse()
     QCheckBox * cbCleanseMerges = new QCheckBox("Cleanse Merges (slow)");
     cbCleanseMerges->setChecked(config->slowCleanseMapMerges);
 
+    QCheckBox * cbContactMerges = new QCheckBox("Contact Merges (PIC)");
+    cbContactMerges->setChecked(config->contactMerges);
+
+    QCheckBox * cbParallelProto = new QCheckBox("Parallel Prototype Build");
+    cbParallelProto->setChecked(config->parallelProtoBuild);
+
+    QCheckBox * cbProtoCache = new QCheckBox("Cache Proto Maps");
+    cbProtoCache->setChecked(config->protoMapCache);
+
+    QCheckBox * cbFlatProto = new QCheckBox("Flat Prototype Build");
+    cbFlatProto->setChecked(config->flatProtoBuild);
+
+    QCheckBox * cbParallelCleanse = new QCheckBox("Parallel Cleanse");
+    cbParallelCleanse->setChecked(config->parallelCleanse);
+
+    QCheckBox * cbSymmetricMotifs = new QCheckBox("Symmetric Motifs");
+    cbSymmetricMotifs->setChecked(config->symmetricMotifs);
+
+    QCheckBox * cbMotifCache = new QCheckBox("Cache Motif Maps");
+    cbMotifCache->setChecked(config->motifMapCache);
+
+    QCheckBox * cbParallelCasings = new QCheckBox("Parallel Casings");
+    cbParallelCasings->setChecked(config->parallelCasings);
+
     connect(cbCleanseMerges,&QCheckBox::clicked,    this,   &page_debug::slot_unDupMerges);
+    connect(cbContactMerges,&QCheckBox::clicked,    this,   [this](bool checked) { config->contactMerges = checked; });
+    connect(cbParallelProto,&QCheckBox::clicked,    this,   [this](bool checked) { config->parallelProtoBuild = checked; });
+    connect(cbProtoCache,   &QCheckBox::clicked,    this,   [this](bool checked) { config->protoMapCache = checked; });
+    connect(cbFlatProto,    &QCheckBox::clicked,    this,   [this](bool checked) { config->flatProtoBuild = checked; });
+    connect(cbParallelCleanse,&QCheckBox::clicked,  this,   [this](bool checked) { config->parallelCleanse = checked; });
+    connect(cbSymmetricMotifs,&QCheckBox::clicked,  this,   [this](bool checked) { config->symmetricMotifs = checked; });
+    connect(cbMotifCache,   &QCheckBox::clicked,    this,   [this](bool checked) { config->motifMapCache = checked; if (!checked) MotifMapCache::clear(); });
+    connect(cbParallelCasings,&QCheckBox::clicked,  this,   [this](bool checked) { config->parallelCasings = checked; });
 
     QHBoxLayout * hbox = new QHBoxLayout;
     hbox->addWidget(cbCleanseMerges);
+    hbox->addWidget(cbContactMerges);
+    hbox->addWidget(cbParallelCleanse);
+    hbox->addWidget(cbParallelCasings);
+
+    QHBoxLayout * hbox2 = new QHBoxLayout;
+    hbox2->addWidget(cbParallelProto);
+    hbox2->addWidget(cbProtoCache);
+    hbox2->addWidget(cbFlatProto);
+    hbox2->addWidget(cbSymmetricMotifs);
+    hbox2->addWidget(cbMotifCache);
+    hbox2->addStretch();
 
     QVBoxLayout * vbox = new QVBoxLayout;
     vbox->addLayout(hbox);
+    vbox->addLayout(hbox2);
     vbox->addStretch();
 
     QGroupBox * gb= new QGroupBox("Cleanse");
@@ -482,9 +555,9 @@ QWidget * page_debug::creatDebugFlags()
     pbEnbDbgFlags->setChecked(Sys::flags->enabled());
     pbEnbDbgView2->setChecked(viewControl->isEnabled(VIEW_DEBUG));
 
-    connect(pbResetStyles,  &QPushButton::clicked,  this, [] { Sys::render(RENDER_RESET_STYLES);} );
-    connect(pbResetProtos,  &QPushButton::clicked,  this, [] { Sys::render(RENDER_RESET_PROTOTYPES);} );
-    connect(pbResetMotifs,  &QPushButton::clicked,  this, [] { Sys::render(RENDER_RESET_MOTIFS);} );
+    connect(pbResetStyles,  &QPushButton::clicked,  this, [] { Sys::invalidate(INV_STYLE);} );
+    connect(pbResetProtos,  &QPushButton::clicked,  this, [] { Sys::invalidate(INV_PROTOTYPE);} );
+    connect(pbResetMotifs,  &QPushButton::clicked,  this, [] { Sys::invalidate(INV_MOTIF);} );
     connect(pbEnbDbgFlags,  &AQPushButton::clicked, this, &page_debug::slot_dbgFlagsClicked);
     connect(pbEnbDbgView2,  &AQPushButton::clicked, this, &page_debug::slot_dbgViewClicked);
     connect(pbClearFlags,   &QPushButton::clicked,  this, &page_debug::slot_clearFlags);
@@ -1405,14 +1478,14 @@ void  page_debug::slot_dbgFlagsClicked(bool checked)
         Sys::debugMapCreate->wipeout();
         Sys::debugMapPaint->wipeout();
     }
-    Sys::render(RENDER_RESET_ALL);
+    Sys::invalidate(INV_MOTIF);
     Sys::viewController->slot_updateView();
 }
 
 void  page_debug::slot_edgeSelectClicked(bool checked)
 {
     Sys::flags->setIndexEnable(checked);
-    Sys::render(RENDER_RESET_STYLES);
+    Sys::invalidate(INV_STYLE);
 }
 
 void  page_debug::slot_triggerClicked(bool checked)
@@ -1444,7 +1517,7 @@ void page_debug::slot_useProtoMap(bool checked)
     else
     {
         Sys::debugMapCreate->wipeout();
-        Sys::render(RENDER_RESET_MOTIFS);
+        Sys::invalidate(INV_MOTIF);
     }
     emit sig_updateView();
 }
@@ -1513,6 +1586,211 @@ void  page_debug::testB()
     Sys::debugView->do_testB(true);
 }
 
+// Compares the scanning UniqueQVector with the hashed UniqueHashQVector
+// for the insert pattern used by map vertices: every push is a new value
+// and a quarter of them are pushed twice.
+void page_debug::benchmarkContainers()
+{
+    QVector<VertexPtr> verts;
+    for (int i=0; i < 20000; i++)
+    {
+        verts.push_back(make_shared<Vertex>(QPointF(i,i)));
+    }
+
+    QString results;
+    QTextStream ts(&results);
+    for (int count : {1000, 5000, 20000})
+    {
+        QElapsedTimer qet;
+
+        qet.start();
+        UniqueQVector<VertexPtr> uvec;
+        for (int i=0; i < count; i++)
+        {
+            uvec.push_back(verts[i]);
+            if ((i % 4) == 0)
+                uvec.push_back(verts[i/2]);
+        }
+        qint64 scanTime = qet.nsecsElapsed();
+
+        qet.start();
+        UniqueHashQVector<VertexPtr> hvec;
+        for (int i=0; i < count; i++)
+        {
+            hvec.push_back(verts[i]);
+            if ((i % 4) == 0)
+                hvec.push_back(verts[i/2]);
+        }
+        qint64 hashTime = qet.nsecsElapsed();
+
+        Q_ASSERT(uvec == hvec);
+        ts << "count=" << count << " UniqueQVector=" << scanTime / 1000 << "us UniqueHashQVector=" << hashTime / 1000 << "us\n";
+    }
+
+    qInfo().noquote() << results;
+
+    QMessageBox box(this);
+    box.setIcon(QMessageBox::Information);
+    box.setText("Container benchmark");
+    box.setInformativeText(results);
+    box.setStandardButtons(QMessageBox::Ok);
+    box.exec();
+}
+
+// Compares the grid clustering in MapCleanser::deDuplicateVertices with the
+// pairwise scan it replaced.  The map is a lattice where every point has up
+// to three jittered copies, and the lattice edges pick copies at random.
+void page_debug::benchmarkCoalesce()
+{
+    const qreal tolerance = Sys::TOL;
+    const qreal jitter    = qSqrt(tolerance) * 0.25;
+
+    QString results;
+    QTextStream ts(&results);
+    for (int side : {10, 20, 40})
+    {
+        QRandomGenerator rng(side);
+        MapPtr map = make_shared<Map>("coalesce bench");
+
+        QVector<QVector<VertexPtr>> copies;
+        for (int i=0; i < side * side; i++)
+        {
+            QPointF pt(i % side, i / side);
+            QVector<VertexPtr> dups;
+            int count = 1 + rng.bounded(3);
+            for (int j=0; j < count; j++)
+            {
+                QPointF offset((rng.generateDouble() - 0.5) * jitter, (rng.generateDouble() - 0.5) * jitter);
+                VertexPtr v = make_shared<Vertex>(pt + offset);
+                map->insertVertex(v);
+                dups.push_back(v);
+            }
+            copies.push_back(dups);
+        }
+
+        auto pick = [&copies,&rng](int i) { const auto & dups = copies[i]; return dups[rng.bounded(dups.size())]; };
+        for (int i=0; i < side * side; i++)
+        {
+            if ((i % side) < side - 1)
+                map->private_insertEdge(make_shared<Edge>(pick(i),pick(i+1)));
+            if ((i / side) < side - 1)
+                map->private_insertEdge(make_shared<Edge>(pick(i),pick(i+side)));
+        }
+
+        MapPtr nestedMap = map->recreate();    // copy() would share the edges
+
+        QElapsedTimer qet;
+
+        qet.start();
+        MapCleanser nested(nestedMap);
+        nested.deDuplicateVerticesNested(tolerance);
+        qint64 nestedTime = qet.nsecsElapsed();
+
+        qet.start();
+        MapCleanser gridded(map);
+        gridded.deDuplicateVertices(tolerance);
+        qint64 gridTime = qet.nsecsElapsed();
+
+        ts << "lattice=" << side << "x" << side
+           << " nested=" << nestedTime / 1000 << "us (" << nestedMap->numVertices() << "v," << nestedMap->numEdges() << "e)"
+           << " grid="   << gridTime   / 1000 << "us (" << map->numVertices()       << "v," << map->numEdges()       << "e)\n";
+    }
+
+    qInfo().noquote() << results;
+
+    QMessageBox box(this);
+    box.setIcon(QMessageBox::Information);
+    box.setText("Coalesce benchmark");
+    box.setInformativeText(results);
+    box.setStandardButtons(QMessageBox::Ok);
+    box.exec();
+}
+
+// Builds stars and rosettes, odd n included, with and without symmetric
+// replication, and checks the two maps have the same vertices and edges.
+// Odd n stars and rosettes are replicated from their first unit alone.
+void page_debug::testRadialReplication()
+{
+    bool symmetric = config->symmetricMotifs;
+    bool cache     = config->motifMapCache;
+    config->motifMapCache = false;      // so both are really built
+
+    auto build = [](int n, bool rosette) -> MapPtr
+    {
+        RadialMotifPtr motif;
+        if (rosette)
+            motif = make_shared<Rosette>(n, 0.0, 3);
+        else
+            motif = make_shared<Star>(n, 2.0, 2);
+        motif->setTile(make_shared<Tile>(n));
+        motif->buildMotifMap();
+        return motif->getMotifMap();
+    };
+
+    QString results;
+    QTextStream ts(&results);
+    int failures = 0;
+    for (bool rosette : {false, true})
+    {
+        for (int n : {5, 7, 9, 8})
+        {
+            QElapsedTimer qet;
+
+            config->symmetricMotifs = false;
+            qet.start();
+            MapPtr merged = build(n,rosette);
+            qint64 mergedTime = qet.nsecsElapsed();
+
+            config->symmetricMotifs = true;
+            qet.start();
+            MapPtr welded = build(n,rosette);
+            qint64 weldedTime = qet.nsecsElapsed();
+
+            bool ok = merged && welded
+                   && merged->numVertices() == welded->numVertices()
+                   && merged->numEdges()    == welded->numEdges();
+            if (ok)
+            {
+                for (const auto & edge : merged->getEdges())
+                {
+                    VertexPtr v1 = welded->getVertex(edge->v1->pt);
+                    VertexPtr v2 = welded->getVertex(edge->v2->pt);
+                    if (!v1 || !v2 || !welded->edgeExists(v1,v2))
+                    {
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+            if (ok)
+            {
+                MapVerifier mv(welded);
+                ok = mv.verify(true);
+            }
+            if (!ok)
+                failures++;
+
+            ts << (rosette ? "rosette" : "star") << " n=" << n << (ok ? " OK" : " FAILED")
+               << " merged=" << mergedTime / 1000 << "us welded=" << weldedTime / 1000 << "us";
+            if (welded)
+                ts << " (" << welded->numVertices() << "v," << welded->numEdges() << "e)";
+            ts << "\n";
+        }
+    }
+
+    config->symmetricMotifs = symmetric;
+    config->motifMapCache   = cache;
+
+    qInfo().noquote() << results;
+
+    QMessageBox box(this);
+    box.setIcon(failures ? QMessageBox::Warning : QMessageBox::Information);
+    box.setText(failures ? QString("Radial replication: %1 failed").arg(failures) : QString("Radial replication OK"));
+    box.setInformativeText(results);
+    box.setStandardButtons(QMessageBox::Ok);
+    box.exec();
+}
+
 void page_debug::slot_startPicker(bool checked)
 {
     pick = checked;
@@ -80,6 +80,9 @@ protected:
     void    examineMosaicXML();
     void    reformatMosaicXML();
     void    reformatOldTemplates();
+    void    benchmarkContainers();
+    void    benchmarkCoalesce();
+    void    testRadialReplication();
     void    reformatTilingXML();
     void    reprocessMosaicXML();
     void    reprocessTilingXML();
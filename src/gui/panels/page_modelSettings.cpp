@@ -423,7 +423,7 @@ void page_modelSettings::slot_mosaicCanvasChanged(int)
     CanvasSettings  & ms = mosaicMaker->getCanvasSettings();
     ms.setCanvasSize(sz);
 
-    emit sig_reconstructView();
+    Sys::invalidate(INV_CANVAS);
 }
 
 void page_modelSettings::slot_mosaicViewChanged(int)
@@ -522,7 +522,7 @@ void page_modelSettings::slot_set_repsDesign(int val)
         cs.setFillData(fd);
     }
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 }
 
 void page_modelSettings::singleton_changed_des(bool checked)
@@ -540,7 +540,7 @@ void page_modelSettings::singleton_changed_des(bool checked)
         cs.setFillData(fd);
     }
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 }
 
 void page_modelSettings::slot_set_repsTiling(int val)
@@ -564,7 +564,7 @@ void page_modelSettings::slot_set_repsTiling(int val)
      || viewControl->isEnabled(VIEW_MAP_EDITOR))
         emit sig_reconstructView();
     else
-        Sys::render(RENDER_RESET_PROTOTYPES);
+        Sys::invalidate(INV_PROTOTYPE);
 }
 
 void page_modelSettings::singleton_changed_tile(bool checked)
@@ -582,7 +582,7 @@ void page_modelSettings::singleton_changed_tile(bool checked)
     cs.setFillData(fd);
     tiling->hdr().setCanvasSettings(cs);
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 
 }
 void page_modelSettings::backgroundColorDesignPick()
@@ -614,7 +614,7 @@ void page_modelSettings::backgroundColorDesignChanged(const QString & str)
     CanvasSettings & ms = mosaicMaker->getCanvasSettings();
     ms.setBackgroundColor(color);
 
-    emit sig_reconstructView();
+    Sys::invalidate(INV_CANVAS);
 }
 
 #ifdef VARIABLE_BOUNDS
@@ -173,7 +173,7 @@ QHBoxLayout * page_mosaic_maker::createFillDataRow()
     connect(xRepMax, &SpinSet::valueChanged, this, &page_mosaic_maker::slot_set_reps);
     connect(yRepMin, &SpinSet::valueChanged, this, &page_mosaic_maker::slot_set_reps);
     connect(yRepMax, &SpinSet::valueChanged, this, &page_mosaic_maker::slot_set_reps);
-    connect(pbRender,&QPushButton::clicked,  this, [] {Sys::render(RENDER_RESET_STYLES);} );
+    connect(pbRender,&QPushButton::clicked,  this, [] {Sys::invalidate(INV_STYLE);} );
     connect(pbClean, &QPushButton::clicked,  this, &page_mosaic_maker::slot_setCleanse);
 
     return hbox;
@@ -701,7 +701,7 @@ void page_mosaic_maker::slot_set_reps()
     CanvasSettings & cs = mosaic->getCanvasSettings();
     cs.setFillData(fd);
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 }
 
 void page_mosaic_maker::slot_setCleanse()
@@ -725,7 +725,7 @@ void page_mosaic_maker::slot_setCleanse()
     proto->setCleanseLevel(level);
     proto->setCleanseSensitivity(sens);
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE,proto);
 }
 
 void page_mosaic_maker::slot_cleansed()
@@ -733,7 +733,7 @@ void page_mosaic_maker::slot_cleansed()
     MosaicPtr mosaic = mosaicMaker->getMosaic();
     if (!mosaic) return;
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 }
 
 void page_mosaic_maker::singleton_changed(bool checked)
@@ -751,7 +751,7 @@ void page_mosaic_maker::singleton_changed(bool checked)
         cs.setFillData(fd);
     }
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 }
 
 void page_mosaic_maker::slot_noaddr(bool checked)
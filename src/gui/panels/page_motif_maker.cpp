@@ -29,7 +29,6 @@
 #include "model/tilings/placed_tile.h"
 #include "model/tilings/tile.h"
 #include "model/tilings/tiling.h"
-#include "sys/enums/erender.h"
 #include "sys/geometry/map.h"
 #include "sys/geometry/map_cleanser.h"
 #include "sys/geometry/map_verifier.h"
@@ -197,7 +196,7 @@ page_motif_maker::page_motif_maker(ControlPanel * cpanel) : panel_page(cpanel,PA
     }
 
 
-    connect(pbRender,           &QPushButton::clicked,              this, [] {Sys::render(RENDER_RESET_MOTIFS);} );
+    connect(pbRender,           &QPushButton::clicked,              this, [] {Sys::invalidate(INV_MOTIF);} );
     connect(pbSwapReg,          &QPushButton::clicked,              this,   &page_motif_maker::slot_swapTileRegularity);
     connect(pbDup,              &QPushButton::clicked,              this,   &page_motif_maker::slot_duplicateCurrent);
     connect(pbDel,              &QPushButton::clicked,              this,   &page_motif_maker::slot_deleteCurrent);
@@ -490,7 +489,7 @@ void page_motif_maker::slot_deleteCurrent()
 
     prototypeMaker->select(MVD_DELEM,proto,false);
 
-    Sys::render(RENDER_RESET_STYLES);   // since protomap already reset
+    Sys::invalidate(INV_STYLE,proto);   // since protomap already reset
 }
 
 void page_motif_maker::slot_swapTileRegularity()
@@ -513,7 +512,7 @@ void page_motif_maker::slot_swapTileRegularity()
     auto btn =  motifMakerWidget->getButton(del);
     motifMakerWidget->delegate(btn,false,true);
 
-    Sys::render(RENDER_RESET_MOTIFS);
+    Sys::invalidate(INV_MOTIF);
 }
 
 void page_motif_maker::slot_prototypeSelected(int row)
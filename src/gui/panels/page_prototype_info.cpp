@@ -46,7 +46,7 @@ page_prototype_info:: page_prototype_info(ControlPanel * cpanel)  : panel_page(c
     auto box3 = buildDistortionsLayout();
 
     connect(widthSpin,        &SpinSet::valueChanged,   this, &page_prototype_info::slot_widthChanged);
-    connect(pbRender,         &QPushButton::clicked,    this, [] { Sys::render(RENDER_RESET_PROTOTYPES);} );
+    connect(pbRender,         &QPushButton::clicked,    this, [] { Sys::invalidate(INV_PROTOTYPE);} );
 
     connect(tilingMaker,   &TilingMaker::sig_tilingLoaded,      this,   &page_prototype_info::populateTables);
     connect(mosaicMaker,   &MosaicMaker::sig_mosaicLoaded,      this,   &page_prototype_info::populateTables);
@@ -266,7 +266,7 @@ QGroupBox * page_tiling_maker::createActionsGroup()
     connect(pbClearTiling,     &QPushButton::clicked,  this, &page_tiling_maker::slot_clearTiling);
     connect(reloadTilingBtn,   &QPushButton::clicked,  this, &page_tiling_maker::slot_reloadTiling);
     connect(dupTilingBtn,      &QPushButton::clicked,  this, &page_tiling_maker::slot_duplicateTiling);
-    connect(pbRender,          &QPushButton::clicked,  this, [] {Sys::render(RENDER_RESET_MOTIFS);} );
+    connect(pbRender,          &QPushButton::clicked,  this, [] {Sys::invalidate(INV_TILING);} );
     connect(chkPropagate,      &QCheckBox::clicked,    tilingMaker, &TilingMaker::slot_propagate_changed);
 
     QGroupBox * actionGroup = new QGroupBox("Actions");
@@ -413,7 +413,7 @@ void ControlPanel::repeatChanged(int id)
 {
     Sys::config->repeatMode = static_cast<eRepeatType>(id);
 
-    Sys::render(RENDER_RESET_PROTOTYPES);
+    Sys::invalidate(INV_PROTOTYPE);
 
     if (Sys::viewController->isEnabled(VIEW_MAP_EDITOR))
     {
@@ -684,6 +684,6 @@ void  ControlPanel::slot_dbgFlagsClicked(bool checked)
         Sys::debugMapCreate->wipeout();
         Sys::debugMapPaint->wipeout();
     }
-    Sys::render(RENDER_RESET_ALL);
+    Sys::invalidate(INV_MOTIF);
     Sys::viewController->slot_updateView();
 }
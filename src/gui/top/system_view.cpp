@@ -197,6 +197,13 @@ void SystemView::paintEvent(QPaintEvent *event)
     processLoadState(Sys::mosaicMaker->getLoadUnit());
 }
 
+// Only the layer asking has changed, so the others can be blitted
+void SystemView::updateLayerView(Layer * layer)
+{
+    layer->contentChanged();
+    QWidget::update();
+}
+
 bool SystemView::viewCanPaint()
 {
     return (( _suspendPaintView || _suspendPaintApp || _suspendPaintDebug) ? false : true) ;
@@ -848,11 +855,13 @@ void ActiveLayers::add(LayerPtr layer)
     //qDebug().noquote() << "adding layer :" << layer->getLayerName();
     WeakLayerPtr wlp = layer;
     layers.push_back(wlp);
+    version++;
 }
 
 void  ActiveLayers::clear()
 {
     layers.clear();
+    version++;
 }
 
 void ActiveLayers::unloadContent()
@@ -912,6 +921,9 @@ void ActiveLayers::paint(QPainter * painter, CropPtr painterCrop)
     QVector<Layer *> layers2 = get();
     std::stable_sort(layers2.begin(),layers2.end(),Layer::sortByZlevelP);  // tempting to move this to addLayer, but if zlevel changed would not be picked up
 
+    // styles fill the debug map as they draw, so it needs them all painted
+    bool useCache = Sys::config->layerImageCache && !contains(VIEW_DEBUG);
+
     for (Layer * layer : std::as_const(layers2))
     {
         if (layer->isVisible())
@@ -926,7 +938,15 @@ void ActiveLayers::paint(QPainter * painter, CropPtr painterCrop)
                 painterCrop->clipPainter(painter,layer->getLayerTransform());
             }
 
-            layer->paint(painter);
+            if (useCache && layer->canCacheImage())
+            {
+                layer->paintCached(painter,version);
+            }
+            else
+            {
+                layer->dropImageCache();
+                layer->paint(painter);
+            }
 
             painter->restore();
         }
@@ -25,6 +25,7 @@ class ActiveLayers
 {
 public:
     void    paint(QPainter * painter, CropPtr paineterCrop);
+    void    invalidate()    { version++; }      // all cached layer images
 
     void    add(LayerPtr layer);
     void    clear();
@@ -37,6 +38,7 @@ public:
 
 private:
     QVector<WeakLayerPtr> layers;
+    quint64               version = 0;
 };
 
 
@@ -113,8 +115,9 @@ protected:
     QColor  getBackgroundColor();
     void    setBackgroundColor(QColor color);
 
-    void    updateView()                            { QWidget::update(); }
-    void    repaintView()                           { QWidget::repaint(); }
+    void    updateView()                            { activeLayers.invalidate(); QWidget::update(); }
+    void    updateLayerView(Layer * layer);
+    void    repaintView()                           { activeLayers.invalidate(); QWidget::repaint(); }
     void    repaint()                               { qFatal("Dont call repaint() directly - use repaintView()"); }
     void    unloadViewers();
     void    raiseView();
@@ -90,6 +90,23 @@ void SystemViewController::slot_updateView()
     }
 }
 
+// an update asked for by a layer, which only changes that layer
+void SystemViewController::slot_updateLayerView()
+{
+    if (theView && Sys::isGuiThread())
+    {
+        Layer * layer = qobject_cast<Layer*>(sender());
+        if (layer)
+        {
+            theView->updateLayerView(layer);
+        }
+        else
+        {
+            theView->updateView();
+        }
+    }
+}
+
 void SystemViewController::slot_unloadView()
 {
     // always unloads so that paint does not fail
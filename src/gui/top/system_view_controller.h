@@ -69,6 +69,7 @@ signals:
 
 public slots:
     void    slot_updateView();
+    void    slot_updateLayerView();
     void    slot_reconstructView();
     void    slot_unloadView();
     void    slot_unloadAll();
@@ -135,6 +135,28 @@ void GeoGraphics::fillPath(QPainterPath path, QPen & pen) const
     }
 }
 
+void GeoGraphics::strokePath(QPainterPath path, const QPen & pen) const
+{
+    for (int i = 0; i < path.elementCount(); i++)
+    {
+        QPainterPath::Element element = path.elementAt(i);
+        QPointF pt = transform.map(QPointF(element.x,element.y));
+        path.setElementPositionAt(i,pt.x(),pt.y());
+    }
+
+    painter->strokePath(path,pen);
+}
+
+// The path is in model coordinates and is not mapped point by point,
+// so a path cached by a style can be filled as it is
+void GeoGraphics::fillModelPath(const QPainterPath & path, const QColor & color) const
+{
+    painter->save();
+    painter->setTransform(transform,true);
+    painter->fillPath(path,QBrush(color));
+    painter->restore();
+}
+
 void GeoGraphics::fillStrokedPath(QPainterPath path, QPen & pen, QPainterPathStroker &ps) const
 {
     for (int i = 0; i < path.elementCount(); i++)
@@ -233,6 +255,42 @@ void GeoGraphics::drawCircle( QPointF origin, int diameter, QPen pen, QBrush bru
     painter->restore();
 }
 
+// The part of the model the painter can draw on: the device, or the clip if
+// there is one, mapped back through the painter and the model transforms.
+// It is padded by margin device pixels for pens which spread past their
+// geometry.  The device size is taken in physical pixels, so with a scaled
+// device it is larger than it need be, never smaller.  An invalid rect
+// means it is not known, and everything should be drawn.
+QRectF GeoGraphics::modelViewRect(qreal margin) const
+{
+    QPaintDevice * device = painter->device();
+    if (!device || device->width() <= 0 || device->height() <= 0)
+    {
+        return QRectF();
+    }
+
+    bool invertible;
+    QTransform world = painter->worldTransform().inverted(&invertible);
+    if (!invertible)
+    {
+        return QRectF();
+    }
+    QRectF rect = world.mapRect(QRectF(0,0,device->width(),device->height()));
+
+    if (painter->hasClipping())
+    {
+        rect = rect.intersected(painter->clipBoundingRect());
+    }
+    rect.adjust(-margin,-margin,margin,margin);
+
+    QTransform inverse = transform.inverted(&invertible);
+    if (!invertible)
+    {
+        return QRectF();
+    }
+    return inverse.mapRect(rect);
+}
+
 QTransform GeoGraphics::getTransform()
 {
     return transform;
@@ -60,6 +60,8 @@ public:
 
     void fillPath(QPainterPath pp, QPen &pen) const;      // not a reference, not const
     void fillStrokedPath(QPainterPath pp, QPen &pen, QPainterPathStroker & ps) const;      // not a reference, not const
+    void fillModelPath(const QPainterPath & pp, const QColor & color) const;               // through the painter transform
+    void strokePath(QPainterPath pp, const QPen & pen) const;                               // not a reference
 
     void drawArrow( QPointF from, QPointF to, qreal length, qreal half_width, QColor color);
     void drawLineArrow(QLineF line, QPen pen);
@@ -72,6 +74,8 @@ public:
 
     QPainter *  getPainter() { return painter; }
 
+    QRectF      modelViewRect(qreal margin = 4.0) const;     // what can be seen, in model units
+
     // Transform functions.
     QTransform  getTransform();
     void        push(QTransform T );
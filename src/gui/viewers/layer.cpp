@@ -18,6 +18,12 @@ Layer::Layer(eViewType viewType,eModelType modelType, QString name)
     visible      = true;
     _viewControl = Sys::viewController;
     debug        = 0; //DEBUG_LAYER | DEBUG_TFORM | DEBUG_XFORM;
+    _contentVersion     = 0;
+    cacheViewVersion    = 0;
+    cacheContentVersion = 0;
+    cacheValid          = false;
+    lastViewVersion     = 0;
+    lastContentVersion  = 0;
     setZLevel(STANDARD_ZLEVEL);
 
     initLayer();
@@ -39,6 +45,12 @@ Layer::Layer(const Layer & other) : QObject()
     subLayers       = other.subLayers;
     xf_model        = other.xf_model;
     debug           = other.debug;
+    _contentVersion = 0;
+    cacheViewVersion    = 0;
+    cacheContentVersion = 0;
+    cacheValid          = false;
+    lastViewVersion     = 0;
+    lastContentVersion  = 0;
 
     initLayer();
     connectSignals();
@@ -59,6 +71,12 @@ Layer::Layer(LayerPtr other)
     subLayers       = other->subLayers;
     xf_model        = other->xf_model;
     debug           = other->debug;
+    _contentVersion = 0;
+    cacheViewVersion    = 0;
+    cacheContentVersion = 0;
+    cacheValid          = false;
+    lastViewVersion     = 0;
+    lastContentVersion  = 0;
 
     initLayer();
     connectSignals();
@@ -88,7 +106,7 @@ void Layer::initLayer()
 void Layer::connectSignals()
 {
     connect(this, &Layer::sig_reconstructView, _viewControl, &SystemViewController::slot_reconstructView);
-    connect(this, &Layer::sig_updateView,      _viewControl, &SystemViewController::slot_updateView);
+    connect(this, &Layer::sig_updateView,      _viewControl, &SystemViewController::slot_updateLayerView);
 
     connect(_viewControl, &SystemViewController::sig_resetLayers, this, &Layer::initLayer);
 
@@ -426,6 +444,62 @@ void Layer::paint(QPainter * painter)
     painter->restore();
 }
 
+// Paints the layer from an image of its last paint, if it is still good.
+// The image is as large as the view, so it is blitted untransformed and any
+// clip already set on the painter applies to it as it would to paint().
+// It is stale when the layer transform, the device, the view version (bumped
+// by requests to update the whole view) or the layer's own content version
+// (bumped by its own requests to update) change.  While any of these are
+// changing from frame to frame, as when panning or zooming, the layer is
+// painted directly, and the image is only redrawn once a frame repeats the
+// last one.  The image is reused while the device size stays the same.
+void Layer::paintCached(QPainter * painter, quint64 viewVersion)
+{
+    QTransform t = getLayerTransform();
+
+    bool settled = (t == lastTransform && viewVersion == lastViewVersion && _contentVersion == lastContentVersion);
+    lastTransform      = t;
+    lastViewVersion    = viewVersion;
+    lastContentVersion = _contentVersion;
+
+    if (!settled)
+    {
+        cacheValid = false;
+        paint(painter);
+        return;
+    }
+
+    QPaintDevice * device = painter->device();
+    qreal dpr    = device->devicePixelRatioF();
+    QSize size   = QSize(device->width(),device->height()) * dpr;
+
+    if (cacheImage.isNull() || cacheImage.size() != size || cacheImage.devicePixelRatio() != dpr)
+    {
+        cacheImage = QImage(size,QImage::Format_ARGB32_Premultiplied);
+        cacheImage.setDevicePixelRatio(dpr);
+        cacheValid = false;
+    }
+
+    if (   !cacheValid
+        || cacheTransform != t
+        || cacheViewVersion != viewVersion
+        || cacheContentVersion != _contentVersion)
+    {
+        cacheImage.fill(Qt::transparent);
+
+        QPainter ipainter(&cacheImage);
+        paint(&ipainter);
+        ipainter.end();
+
+        cacheValid          = true;
+        cacheTransform      = t;
+        cacheViewVersion    = viewVersion;
+        cacheContentVersion = _contentVersion;
+    }
+
+    painter->drawImage(QPointF(0,0),cacheImage);
+}
+
 void Layer::id_layer()
 {
     qInfo().noquote() << layerName() << sViewerType[viewType()];
@@ -2,6 +2,7 @@
 #ifndef TPM_LAYER_H
 #define TPM_LAYER_H
 
+#include <QImage>
 #include <QObject>
 #include <QPen>
 #include "sys/enums/eviewtype.h"
@@ -32,6 +33,7 @@ public:
     virtual ~Layer();
 
     virtual void paint(QPainter * painter);
+            void paintCached(QPainter * painter, quint64 viewVersion);
 
     void        initLayer();
 
@@ -61,6 +63,10 @@ public:
     
     virtual void unloadLayerContent() {}
 
+    virtual bool canCacheImage()        { return false; }   // paint() only depends on the transform and content
+    void        contentChanged()        { _contentVersion++; }
+    void        dropImageCache()        { cacheValid = false; if (!cacheImage.isNull()) cacheImage = QImage(); }
+
     virtual const Xform &   getModelXform();
     virtual void            setModelXform(const Xform & xf, bool update, uint sigid);
     
@@ -143,6 +149,16 @@ private:
 
     QTransform  layerTransform;     // calculated
 
+    quint64     _contentVersion;    // bumped when the layer asks to be redrawn
+    QImage      cacheImage;         // the last paint(), see paintCached()
+    bool        cacheValid;
+    QTransform  cacheTransform;
+    quint64     cacheViewVersion;
+    quint64     cacheContentVersion;
+    QTransform  lastTransform;      // of the previous frame
+    quint64     lastViewVersion;
+    quint64     lastContentVersion;
+
     bool        visible;
     eZLevel     _zlevel;
 
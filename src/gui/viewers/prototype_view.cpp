@@ -89,7 +89,7 @@ void PrototypeView::drawProto(const int mode, ProtoPtr proto)
 
         QPen pen(colors.mapColor,lineWidth);
 
-        NeighbourMap nmap(map);
+        NeighbourMapPtr nmap = map->getNeighbourMap();
 
         for (const auto & edge : std::as_const(map->getEdges()))
         {
@@ -97,7 +97,7 @@ void PrototypeView::drawProto(const int mode, ProtoPtr proto)
 #if 0
             QColor c1,c2;
 
-            int num1 = nmap.getNeighbours(edge->v1)->numNeighbours();
+            int num1 = nmap->numNeighbours(edge->v1);
             switch (num1)
             {
             case 2:
@@ -114,7 +114,7 @@ void PrototypeView::drawProto(const int mode, ProtoPtr proto)
                 break;
             }
 
-            int num2 = nmap.getNeighbours(edge->v2)->numNeighbours();
+            int num2 = nmap->numNeighbours(edge->v2);
             switch (num2)
             {
             case 2:
@@ -303,6 +303,13 @@ void MosaicMaker::sm_takeUp(MosaicEvent & mosEvent)
         sm_resetStyles();
         break;
 
+    case MOSM_PROTO_MOTIF_CHANGED:
+        if (proto)
+            _mosaic->resetStyleMaps(proto);
+        else
+            sm_resetStyles();
+        break;
+
     case MOSM_PROTO_DELETED:
         sm_removePrototype(proto);
         break;
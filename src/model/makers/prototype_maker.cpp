@@ -599,10 +599,31 @@ void PrototypeMaker::sm_takeUp(ProtoEvent &protoEvent)
     case PROM_MOTIF_CHANGED:
         if (getPropagate())
         {
-            sm_resetProtoMaps();
+            // when the changed element is known only its prototype is rebuilt,
+            // and that prototype keeps the maps of its other elements
+            auto proto = getPrototype(tiling);
+            DELPtr del;
+            if (proto && protoEvent.tile)
+            {
+                for (const auto & d : proto->getDesignElements())
+                {
+                    if (d->getTile() == protoEvent.tile)
+                        del = d;
+                }
+            }
             MosaicEvent mosaicEvent;
-            mosaicEvent.event     = MOSM_PROTO_CHANGED;
-            mosaicEvent.prototype = getPrototype(tiling);
+            mosaicEvent.prototype = proto;
+            if (del)
+            {
+                if (!proto->wipeoutElementMap(del))
+                    proto->wipeoutProtoMap();
+                mosaicEvent.event = MOSM_PROTO_MOTIF_CHANGED;
+            }
+            else
+            {
+                sm_resetProtoMaps();
+                mosaicEvent.event = MOSM_PROTO_CHANGED;
+            }
             mosaicMaker->sm_takeUp(mosaicEvent);
         }
         break;
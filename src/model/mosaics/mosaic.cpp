@@ -314,6 +314,17 @@ void Mosaic::resetStyleMaps()
     }
 }
 
+void Mosaic::resetStyleMaps(const ProtoPtr & proto)
+{
+    for (const auto & style : std::as_const(styleSet))
+    {
+        if (style->getPrototype() == proto)
+        {
+            style->resetStyleRepresentation();
+        }
+    }
+}
+
 void Mosaic::resetProtoMaps()
 {
     ProtoPtr nullProto;
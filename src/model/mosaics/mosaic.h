@@ -25,6 +25,7 @@ public:
     ~Mosaic();
 
     void        resetStyleMaps();
+    void        resetStyleMaps(const ProtoPtr & proto);
     void        resetProtoMaps();
     void        build();
     bool        isBuilt();
@@ -22,6 +22,7 @@ public:
 
     QString getMotifDesc()    override { return "ExplicitMapMotif"; }
     void    dump()          override { qDebug().noquote() << getMotifDesc(); }
+    bool    canCacheMap()   override { return false; }  // the map is the data
 
     MapPtr  newExplicitMap();
     void    setExplicitMap(MapPtr map);
@@ -29,8 +29,7 @@ InferredMotif::InferredMotif() : IrregularMotif()
 InferredMotif::InferredMotif(const InferredMotif & other) : IrregularMotif(other)
 {
     setMotifType(MOTIF_TYPE_INFERRED);
-    tiling       = other.tiling;
-    allMotifMids = other.allMotifMids;
+    wProto       = other.wProto;
     debugContacts = false;
 }
 
@@ -43,8 +42,7 @@ InferredMotif::InferredMotif(const Motif &other) : IrregularMotif(other)
         try
         {
             auto inf = dynamic_cast<const InferredMotif&>(other);
-            tiling        = inf.tiling;
-            allMotifMids  = inf.allMotifMids;
+            wProto        = inf.wProto;
         }
         catch(std::bad_cast &)
         {
@@ -62,9 +60,7 @@ InferredMotif::InferredMotif(MotifPtr other) : IrregularMotif(other)
         try
         {
             auto inf     = std::dynamic_pointer_cast<InferredMotif>(other);
-            tiling       = inf->tiling;
-            allMotifMids = inf->allMotifMids;
-
+            wProto       = inf->wProto;
         }
         catch(std::bad_cast &)
         {
@@ -111,14 +107,21 @@ void InferredMotif::infer()
 
     qDebug() << "InferredMotif::infer()  tile-sides :" << getTile()->numEdges();
 
+    TileMidIndexPtr midIndex = proto->getTileMidIndex();
+    if (!midIndex || midIndex->getMids().isEmpty())
+    {
+        qWarning() << "InferreMotif cannot infer - not set up";
+        return;
+    }
+
     // Get the index of a good transform for this tile.
-    int cur              = findPrimaryTile(getTile());
+    int cur              = midIndex->primaryTile(getTile(),debugContacts);
     qDebug() << "primary feature index=" << cur;
-    MidsPtr primaryMids  = allMotifMids[cur];
+    MidsPtr primaryMids  = midIndex->getMids()[cur];
     Q_ASSERT(primaryMids);
 
     // adjacencies
-    QVector<AdjacentTilePtr> adjacentTiles = getAdjacenctTiles(primaryMids, cur);
+    QVector<AdjacentTilePtr> adjacentTiles = midIndex->adjacentTiles(cur,debugContacts);
     qDebug() << "adjacenct tiles =" << adjacentTiles.size();
 
     // Get a map for each motif in the prototype
@@ -565,7 +568,7 @@ void InferredMotif::setupInfer(ProtoPtr proto)
 {
     wProto = proto;
 
-    tiling = proto->getTiling();
+    TilingPtr tiling = proto->getTiling();
     if (!tiling)
     {
         qDebug() << "Infer::Infer = tiling is null";
@@ -573,143 +576,39 @@ void InferredMotif::setupInfer(ProtoPtr proto)
     }
 
     qDebug().noquote() << "Infer::setup=" << proto.get()  << "tiling=" << tiling.get();
-
-    // I'm going to generate all the tiles in the translational units
-    // (x,y) where -1 <= x, y <= 1.  This is guaranteed to surround
-    // every tile in the (0,0) unit by tiles.  You can then get
-    // a sense of what other tiles surround a tile on every edge.
-    allMotifMids.clear();
-    for( int y = -1; y <= 1; ++y )
-    {
-        for( int x = -1; x <= 1; ++x )
-        {
-            // Building a 3x3 tiling of the prototype.
-            // Create placed_points instances for all the tiles in the nine translational units
-            QPointF pt   = (tiling->hdr().getTrans1() * static_cast<qreal>(x)) + (tiling->hdr().getTrans2() * static_cast<qreal>(y));
-            QTransform T = QTransform::fromTranslate(pt.x(),pt.y());
-
-            const PlacedTiles tilingUnit = tiling->unit().getIncluded();
-            for (const auto & placedTile : std::as_const(tilingUnit))
-            {
-                QTransform Tf   = placedTile->getPlacement() * T;
-                TilePtr tile    = placedTile->getTile();
-
-                QPolygonF t_pts = Tf.map(tile->getPoints());
-                EdgePoly t_ep   = tile->getEdgePoly().map(Tf);
-
-                Points tileMidpoints;
-                int sz = tile->numPoints();
-                for(int idx = 0; idx < sz; ++idx )
-                {
-                    tileMidpoints << Geo::convexSum(t_pts[idx], t_pts[(idx+1)%sz], 0.5 );
-                }
-
-                allMotifMids << make_shared<TileMidPoints>(make_shared<PlacedTile>(tile,Tf), tileMidpoints, t_ep);
-            }
-        }
-    }
 }
 
-// Choose an appropriate transform of the tile to infer, i.e.
-// one that is surrounded by other tiles.  That means that we
-// should just find an instance of that tile in the (0,0) unit.
-int InferredMotif::findPrimaryTile(TilePtr tile )
+// Taken from the prototype each time, so that an index it has rebuilt,
+// after a wipeout or an edit to the tiling, reaches its inferred motifs
+TileMidIndexPtr InferredMotif::getMidIndex()
 {
-    // The start and end of the tiles in the (0,0) unit.
-    int count = tiling->unit().numIncluded();
-    int start = count * 4;
-    int end   = count * 5;
-    int cur_reg_count = -1;
-    int cur           = -1;
-
-    for( int idx = start; idx < end; ++idx )
-    {
-        MidsPtr pp = allMotifMids[idx];
-
-        if (pp->getTile() == tile)
-        {
-            // Count the number of regular tiles surrounding this one,
-            // in the case a tile is not always surrounded by the same
-            // tiles, we want to select the one with teh most regulars.
-            QVector<AdjacentTilePtr> adjs = getAdjacenctTiles(pp, idx);
-            if ( adjs.isEmpty() )
-            {
-                continue;
-            }
-
-            int new_reg_count = 0;
-            for ( int i = 0; i < adjs.size(); i++ )
-            {
-                if ( adjs[i] != nullptr )
-                {
-                    if ( adjs[i]->placedTile->getTile()->isRegular() )
-                    {
-                        new_reg_count++;
-                    }
-                }
-            }
-            if ( new_reg_count > cur_reg_count )
-            {
-                cur_reg_count = new_reg_count;
-                cur = idx;
-            }
-        }
-    }
-
-    if( cur == -1 )
+    ProtoPtr proto = wProto.lock();
+    if (!proto)
     {
-        qWarning("Couldn't find tile in (0,0) unit!");
-        cur = 0;
+        return TileMidIndexPtr();
     }
-
-    qDebug() << "Primary tile index =" << cur;
-    return cur;
+    return proto->getTileMidIndex();
 }
 
-QVector<AdjacentTilePtr> InferredMotif::getAdjacenctTiles(MidsPtr pp, int main_idx)
+// The tiles whose motif maps this inference reads
+QVector<TilePtr> InferredMotif::getAdjacentTiles()
 {
-    QVector<AdjacentTilePtr> ret;
-    const QVector<QPointF> & mid_points  = pp->getTileMidPoints();
-    for (auto & pt : std::as_const(mid_points))
+    QVector<TilePtr> tiles;
+    TileMidIndexPtr midIndex = getMidIndex();
+    if (!midIndex || midIndex->getMids().isEmpty())
     {
-        AdjacentTilePtr ai = getAdjacency(pt, main_idx);
-        if (ai)
-        {
-            ret.push_back(ai);
-        }
+        return tiles;
     }
-    return ret;
-}
-
-// For this edge of the tile being inferred, find the edges of neighbouring tiles and store.
-AdjacentTilePtr InferredMotif::getAdjacency(QPointF main_point, int main_idx)
-{
-    if (debugContacts) qDebug() << "Searching for adjacency for " << main_point;
 
-    AdjacentTilePtr ap;
-    qreal tolerance = 1e-12;
-    while (tolerance < 5.0)
+    int cur = midIndex->primaryTile(getTile());
+    QVector<AdjacentTilePtr> adjacentTiles = midIndex->adjacentTiles(cur);
+    for (const auto & adj : std::as_const(adjacentTiles))
     {
-        for (int idx = 0; idx < allMotifMids.size(); ++idx)
+        TilePtr tile = adj->placedTile->getTile();
+        if (!tiles.contains(tile))
         {
-            if (idx == main_idx)
-            {
-                continue;
-            }
-
-            MidsPtr pcur = allMotifMids[idx];
-            const QVector<QPointF> & mid_points  = pcur->getTileMidPoints();
-            for (auto & mid : std::as_const(mid_points))
-            {
-                if (Loose::Near(mid, main_point, tolerance))
-                {
-                    if (debugContacts) qDebug() << "Found with tolerance " << tolerance ;
-                    ap = make_shared<AdjacenctTile>(pcur->getPlacedTile(), tolerance);
-                    return ap;
-                }
-            }
+            tiles.push_back(tile);
         }
-        tolerance *= 2;
     }
-    return ap;
+    return tiles;
 }
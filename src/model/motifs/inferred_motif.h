@@ -13,6 +13,7 @@ typedef std::shared_ptr<class AdjacenctTile>    AdjacentTilePtr;
 typedef std::shared_ptr<class Tiling>           TilingPtr;
 typedef std::shared_ptr<class TileMidPoints>    MidsPtr;
 typedef std::shared_ptr<class Contact>          ContactPtr;
+typedef std::shared_ptr<class TileMidIndex>     TileMidIndexPtr;
 
 typedef std::weak_ptr<Prototype>                WeakProtoPtr;
 
@@ -37,30 +38,27 @@ public:
     InferredMotif(MotifPtr other);
 
     void                setupInfer(ProtoPtr proto);
+    QVector<TilePtr>    getAdjacentTiles();
     virtual QString     getMotifDesc()    override { return "InferredMotif"; }
     virtual void        dump()          override { qDebug().noquote() << getMotifDesc(); }
+    bool                canCacheMap()   override { return false; }  // depends on the neighbours
 
     bool                hasDebugContacts() { return debugContacts; }
     const QVector<ContactPtr> & getDebugContacts() { return debugContactPts; }
 
 protected:
     void                infer() override;    // "Normal" magic inferring
+    TileMidIndexPtr     getMidIndex();
 
     QVector<ContactPtr> buildContacts(MidsPtr pp, const QVector<AdjacentTilePtr> &adjs);
     bool                isColinear( QPointF p, QPointF q, QPointF a );
     int                 lexCompareDistances(eKind kind1, qreal dist1, eKind kind2, qreal dist2 );
 
-    int                      findPrimaryTile(TilePtr tile);
-    AdjacentTilePtr          getAdjacency(QPointF main_point, int main_idx );
-    QVector<AdjacentTilePtr> getAdjacenctTiles(MidsPtr pp, int main_idx );
-
 
 private:
     WeakProtoPtr            wProto;
 
     QMap<TilePtr,MapPtr>    adjacentTileMaps;
-    TilingPtr               tiling;
-    QVector<MidsPtr>        allMotifMids;
 
     bool                    debugContacts;
     QVector<ContactPtr>     debugContactPts;
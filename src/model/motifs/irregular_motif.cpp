@@ -1,5 +1,7 @@
 #include <QDebug>
 #include "model/motifs/irregular_motif.h"
+#include "model/motifs/motif_map_cache.h"
+#include "model/settings/configuration.h"
 #include "model/tilings/tile.h"
 #include "sys/geometry/map.h"
 #include "sys/geometry/map_verifier.h"
@@ -108,6 +110,24 @@ MapPtr IrregularMotif::getMotifMap()
 void IrregularMotif::buildMotifMap()
 {
     Q_ASSERT(getTile());
+
+    QByteArray cacheKey;
+    if (Sys::config->motifMapCache && canCacheMap())
+    {
+        cacheKey = MotifMapCache::key(this);
+        MotifMapCache::Entry entry;
+        if (MotifMapCache::lookup(cacheKey,entry))
+        {
+            motifMap = entry.motifMap;
+            irr_buildMotifBoundary();
+            for (ExtenderPtr extender : getExtenders())
+            {
+                extender->buildExtendedBoundary();
+            }
+            return;
+        }
+    }
+
     infer();
     if (motifMap)
     {
@@ -115,9 +135,22 @@ void IrregularMotif::buildMotifMap()
         irr_completeMap();
         irr_buildMotifBoundary();
         irr_extendMaps();
+
+        if (!cacheKey.isEmpty())
+        {
+            MotifMapCache::Entry entry;
+            entry.motifMap = motifMap;
+            MotifMapCache::store(cacheKey,entry);
+        }
     }
 }
 
+void IrregularMotif::writeMapKey(QDataStream & ds)
+{
+    Motif::writeMapKey(ds);
+    ds << skip << d << s << q << r << progressive;
+}
+
 void IrregularMotif::irr_extendMaps()
 {
     for (ExtenderPtr extender : getExtenders())
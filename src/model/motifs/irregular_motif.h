@@ -38,6 +38,7 @@ public:
     QTransform      getDELTransform() override;
 
     bool equals(const MotifPtr other) override;
+    void writeMapKey(QDataStream & ds) override;
 
     virtual void    dump()            override;
 
@@ -13,6 +13,7 @@
 #include "model/motifs/motif.h"
 #include "sys/geometry/edge.h"
 #include "sys/geometry/map.h"
+#include "sys/geometry/vertex.h"
 #include "model/tilings/tile.h"
 
 using std::make_shared;
@@ -114,6 +115,38 @@ bool Motif::equals(const  MotifPtr other)
     return true;
 }
 
+// The key of the MotifMapCache.  The motif boundary is left out
+// because irregular motifs derive it from the tile while building.
+void Motif::writeMapKey(QDataStream & ds)
+{
+    ds << qint32(motifType) << getMotifDesc() << qint32(_n) << motifScale << motifRotate;
+    ds << qint32(version) << cleanseVal << sensitivity;
+
+    ds << qint32(_extenders.size());
+    for (const auto & extender : std::as_const(_extenders))
+    {
+        const ExtendedBoundary & eb = extender->getExtendedBoundary();
+        ds << qint32(eb.getSides()) << eb.getScale() << eb.getRotate();
+        ds << extender->getExtendRays() << extender->getExtendTipsToBound() << extender->getExtendBoundaryToTile()
+           << extender->getConnectRays() << extender->getEmbedBoundary() << extender->getEmbedTile();
+    }
+
+    ds << bool(connector);
+
+    if (!_tile)
+    {
+        ds << qint32(-1);
+        return;
+    }
+    ds << qint32(_tile->get().size());
+    for (const auto & edge : std::as_const(_tile->get()))
+    {
+        ds << edge->v1->pt << edge->v2->pt << edge->isCurve();
+        if (edge->isCurve())
+            ds << edge->getArcCenter() << qint32(edge->getCurveType());
+    }
+}
+
 bool Motif::isIrregular() const
 {
     switch (motifType)
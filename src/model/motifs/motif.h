@@ -14,6 +14,7 @@
 // understand different ways of bulding maps, but have the advantage
 // of being parameterizable at a high level.
 
+#include <QDataStream>
 #include <QPolygonF>
 #include <QGraphicsItem>
 #include <QPainter>
@@ -87,6 +88,9 @@ public:
     qreal           getCleanseSensitivity()         { return sensitivity; }
 
     virtual bool    equals(const  MotifPtr other);
+
+    virtual bool    canCacheMap()                   { return true; }
+    virtual void    writeMapKey(QDataStream & ds);  // what the motif map is built from
     static int      modulo(int i, int sz);
 
     virtual void    dump() = 0;
@@ -12,6 +12,13 @@ MotifConnector::MotifConnector()
     cscale    = 1.0;
 }
 
+// restores the scale of a build taken from the MotifMapCache
+void MotifConnector::setScale(qreal scale)
+{
+    cscale = scale;
+    emit sig_scaleChanged();
+}
+
 qreal MotifConnector::build(RadialMotif * motif)
 {
     RaySet & set1 = motif->getRaySet1();
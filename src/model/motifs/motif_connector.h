@@ -16,6 +16,7 @@ public:
 
     qreal   build(RadialMotif * motif);
     qreal   getScale()   { return cscale; }
+    void    setScale(qreal scale);
 
 signals:
     void    sig_scaleChanged();
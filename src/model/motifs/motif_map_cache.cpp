@@ -0,0 +1,100 @@
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "model/motifs/motif_map_cache.h"
+#include "model/motifs/motif.h"
+#include "sys/geometry/map.h"
+#include "sys/geometry/map_arena.h"
+
+QMutex                                  MotifMapCache::mutex;
+QHash<QByteArray,MotifMapCache::Entry>  MotifMapCache::entries;
+QList<QByteArray>                       MotifMapCache::order;
+int                                     MotifMapCache::hits   = 0;
+int                                     MotifMapCache::misses = 0;
+
+QByteArray MotifMapCache::key(Motif * motif)
+{
+    QByteArray data;
+    QDataStream ds(&data,QIODevice::WriteOnly);
+    ds.setVersion(QDataStream::Qt_6_0);
+
+    ds << qint64(MOTIF_MAP_CACHE_VERSION);
+    motif->writeMapKey(ds);
+
+    return QCryptographicHash::hash(data,QCryptographicHash::Sha1);
+}
+
+bool MotifMapCache::lookup(const QByteArray & key, Entry & entry)
+{
+    // copying writes the copy links into the source vertices,
+    // so readers of an entry are serialised too
+    QMutexLocker locker(&mutex);
+    auto it = entries.constFind(key);
+    if (it == entries.constEnd())
+    {
+        misses++;
+        return false;
+    }
+    hits++;
+    entry = copy(it.value());
+    return true;
+}
+
+void MotifMapCache::store(const QByteArray & key, const Entry & entry)
+{
+    if (!entry.motifMap || entry.motifMap->isEmpty())
+    {
+        return;
+    }
+
+    Entry stored = copy(entry);
+
+    QMutexLocker locker(&mutex);
+    if (entries.contains(key))
+    {
+        return;     // built concurrently by an equal motif
+    }
+    entries.insert(key,stored);
+    order.push_back(key);
+
+    while (order.size() > MOTIF_MAP_CACHE_MAX)
+    {
+        entries.remove(order.takeFirst());
+    }
+}
+
+void MotifMapCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    qDebug() << "MotifMapCache::clear" << entries.size() << "entries" << "hits:" << hits << "misses:" << misses;
+    entries.clear();
+    order.clear();
+    hits   = 0;
+    misses = 0;
+}
+
+int MotifMapCache::size()
+{
+    QMutexLocker locker(&mutex);
+    return entries.size();
+}
+
+// Deep copies.  Cached maps outlive any prototype, so are never put in its arena
+MotifMapCache::Entry MotifMapCache::copy(const Entry & entry)
+{
+    MapArena::Scope scope;
+    scope.enter(nullptr);
+
+    Entry e;
+    e.motifMap     = entry.motifMap->recreate();
+    if (entry.unitMap)
+        e.unitMap  = entry.unitMap->recreate();
+    if (entry.unitMap2)
+        e.unitMap2 = entry.unitMap2->recreate();
+    e.raySet1      = entry.raySet1;
+    e.raySet2      = entry.raySet2;
+    e.connectScale = entry.connectScale;
+    return e;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef MOTIF_MAP_CACHE_H
+#define MOTIF_MAP_CACHE_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A process-wide cache of built motif maps.
+//
+// Equal motifs on equal tiles turn up in many design elements and many
+// mosaics, and each one used to build, replicate and cleanse the same map.
+// Entries are keyed by a hash of everything a motif writes in writeMapKey()
+// (type, parameters, tile, extenders and connector), so they are never
+// stale and live until cleared or evicted.
+//
+// The stored maps are private to the cache and never change: lookup() and
+// store() both copy, so motifs own their maps as before and are free to
+// edit or merge them.  It is thread safe, since the motifs of a prototype
+// are built concurrently.
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include "model/motifs/radial_ray.h"
+
+typedef std::shared_ptr<class Map>      MapPtr;
+
+class Motif;
+
+#define MOTIF_MAP_CACHE_VERSION 1
+#define MOTIF_MAP_CACHE_MAX     256     // entries
+
+class MotifMapCache
+{
+public:
+    class Entry
+    {
+    public:
+        Entry() { connectScale = 1.0; }
+
+        MapPtr      motifMap;
+        MapPtr      unitMap;        // radial motifs only
+        MapPtr      unitMap2;
+        RaySet      raySet1;
+        RaySet      raySet2;
+        qreal       connectScale;
+    };
+
+    static QByteArray key(Motif * motif);
+
+    static bool    lookup(const QByteArray & key, Entry & entry);
+    static void    store(const QByteArray & key, const Entry & entry);
+    static void    clear();
+
+    static int     size();
+    static int     hits;
+    static int     misses;
+
+protected:
+    static Entry   copy(const Entry & entry);
+
+private:
+    static QMutex                   mutex;
+    static QHash<QByteArray,Entry>  entries;
+    static QList<QByteArray>        order;      // oldest first
+};
+
+#endif
@@ -14,11 +14,17 @@
 #include <QtMath>
 #include <QDebug>
 #include "model/motifs/radial_motif.h"
+#include "model/motifs/motif_map_cache.h"
 #include "model/tilings/tile.h"
+#include "model/settings/configuration.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/edge_index.h"
+#include "sys/geometry/loose.h"
 #include "sys/geometry/map.h"
 #include "sys/geometry/map.h"
 #include "sys/geometry/map_cleanser.h"
 #include "sys/geometry/map_verifier.h"
+#include "sys/geometry/vertex.h"
 
 using std::make_shared;
 
@@ -105,8 +111,24 @@ void RadialMotif::setInscribe(bool enb)
     resetMotifMap();
 }
 
+void RadialMotif::writeMapKey(QDataStream & ds)
+{
+    Motif::writeMapKey(ds);
+    ds << inscribe << onPoint << Sys::config->symmetricMotifs;
+}
+
 void RadialMotif::buildMotifMap()
 {
+    QByteArray cacheKey;
+    if (Sys::config->motifMapCache && !Sys::dontReplicate && canCacheMap())
+    {
+        cacheKey = MotifMapCache::key(this);
+        if (fetchMotifMap(cacheKey))
+        {
+            return;
+        }
+    }
+
     buildUnitMap();
 
     for (ExtenderPtr extender : getExtenders())
@@ -189,6 +211,50 @@ void RadialMotif::buildMotifMap()
         MapCleanser mc(motifMap);
         mc.cleanse(cleanseVal,sensitivity);
     }
+
+    if (!cacheKey.isEmpty())
+    {
+        MotifMapCache::Entry entry;
+        entry.motifMap = motifMap;
+        entry.unitMap  = unitMap;
+        entry.unitMap2 = unitMap2;
+        entry.raySet1  = raySet1;
+        entry.raySet2  = raySet2;
+        if (connector)
+        {
+            entry.connectScale = connector->getScale();
+        }
+        MotifMapCache::store(cacheKey,entry);
+    }
+}
+
+// Takes a build of an equal motif from the cache, leaving the motif as the build would
+bool RadialMotif::fetchMotifMap(const QByteArray & cacheKey)
+{
+    MotifMapCache::Entry entry;
+    if (!MotifMapCache::lookup(cacheKey,entry))
+    {
+        return false;
+    }
+
+    motifMap = entry.motifMap;
+    unitMap  = entry.unitMap;
+    unitMap2 = entry.unitMap2;
+    raySet1  = entry.raySet1;
+    raySet2  = entry.raySet2;
+
+    for (ExtenderPtr extender : getExtenders())
+    {
+        extender->buildExtendedBoundary();
+    }
+
+    ConnectPtr connector = getRadialConnector();
+    if (connector)
+    {
+        connector->setScale(entry.connectScale);
+        setMotifScale(1.0);
+    }
+    return true;
 }
 
 MapPtr RadialMotif::createUnitMapFromRays(RaySet & set)
@@ -210,26 +276,140 @@ MapPtr RadialMotif::createUnitMapFromRays(RaySet & set)
 
 void RadialMotif::replicate()
 {
-    QTransform T2 = radialRotationTr * radialRotationTr;       // rotaional transform
+    bool rotated = isRotatedUnit();
+    if (Sys::config->symmetricMotifs && unitMap && (!unitMap2 || rotated || (getN() % 2) == 0))
+    {
+        replicateSymmetric(rotated);
+    }
+    else
+    {
+        QTransform T2 = radialRotationTr * radialRotationTr;       // rotaional transform
 
-    motifMap = make_shared<Map>("Radial replicated unit map");
+        motifMap = make_shared<Map>("Radial replicated unit map");
+
+        for( int idx = 0; idx < getN(); idx++)
+        {
+            if (idx & 1)
+            {
+                motifMap->mergeMap(unitMap2);
+                unitMap->transform(T2);
+                unitMap2->transform(T2);
+            }
+            else
+            {
+                motifMap->mergeMap(unitMap);
+            }
+        }
+    }
+
+    MapVerifier mv(motifMap);
+    mv.verify();
+}
 
-    for( int idx = 0; idx < getN(); idx++)
+// The unit (or the two units, when the second one alternates with the
+// first) is the fundamental region of a rotation which generates the whole
+// figure.  When the second unit is only the first one rotated a step, as
+// for stars and rosettes, the first unit alone is the region, and odd n
+// need no pairing.  Which of its edges meet another copy is worked out once, against
+// the rotated copies whose bounds overlap it.  By symmetry the same edges
+// are the seams of every copy, so only they are intersection tested as the
+// copies are merged, and the rest are just welded in.
+void RadialMotif::replicateSymmetric(bool rotatedUnit)
+{
+    MapPtr     cell;
+    QTransform step;
+    int        copies;
+    if (unitMap2 && !rotatedUnit)
     {
-        if (idx & 1)
+        cell = make_shared<Map>("Radial cell");
+        cell->mergeMap(unitMap);
+        cell->mergeMap(unitMap2);
+        step   = radialRotationTr * radialRotationTr;
+        copies = getN() / 2;
+    }
+    else
+    {
+        cell   = unitMap;
+        step   = radialRotationTr;
+        copies = getN();
+    }
+
+    QRectF bounds;
+    for (const auto & edge : cell->getEdges())
+    {
+        bounds |= EdgeIndex::bounds(edge);
+    }
+    bounds.adjust(-Sys::NEAR_TOL,-Sys::NEAR_TOL,Sys::NEAR_TOL,Sys::NEAR_TOL);
+
+    std::unordered_set<const Edge*> seams;
+    QTransform T = step;
+    for (int j = 1; j < copies; j++, T = T * step)
+    {
+        if (!T.mapRect(bounds).intersects(bounds))
         {
-            motifMap->mergeMap(unitMap2);
-            unitMap->transform(T2);
-            unitMap2->transform(T2);
+            continue;
         }
-        else
+
+        MapPtr other = cell->getTransformed(T);
+        for (const auto & edge : cell->getEdges())
         {
-            motifMap->mergeMap(unitMap);
+            if (seams.count(edge.get()))
+            {
+                continue;
+            }
+            // meeting at a vertex includes copies which share an edge
+            QVector<IsectPoint> points;
+            other->findIntersectionPoints(edge,points);
+            if (!points.isEmpty() || other->getVertex(edge->v1->pt) || other->getVertex(edge->v2->pt))
+            {
+                seams.insert(edge.get());
+            }
         }
     }
 
-    MapVerifier mv(motifMap);
-    mv.verify();
+    Placements placements;
+    T.reset();
+    for (int j = 0; j < copies; j++, T = T * step)
+    {
+        placements.push_back(T);
+    }
+
+    motifMap = make_shared<Map>("Radial replicated unit map");
+    motifMap->mergeSeamedMany(cell,placements,seams);
+
+    qDebug() << "RadialMotif symmetric replication: copies" << copies << "seam edges" << seams.size() << "of" << cell->numEdges();
+}
+
+// True when the second unit is the first one rotated by one radial step.
+// Units are a few edges, so they are just compared pairwise.
+bool RadialMotif::isRotatedUnit()
+{
+    if (!unitMap || !unitMap2 || unitMap->numEdges() != unitMap2->numEdges())
+    {
+        return false;
+    }
+
+    for (const auto & edge : unitMap->getEdges())
+    {
+        QPointF p1 = radialRotationTr.map(edge->v1->pt);
+        QPointF p2 = radialRotationTr.map(edge->v2->pt);
+        bool found = false;
+        for (const auto & other : unitMap2->getEdges())
+        {
+            bool same =    (Loose::equalsPt(other->v1->pt,p1) && Loose::equalsPt(other->v2->pt,p2))
+                        || (Loose::equalsPt(other->v1->pt,p2) && Loose::equalsPt(other->v2->pt,p1));
+            if (same && other->getType() == edge->getType() && (!edge->isCurve() || other->getCurveType() == edge->getCurveType()))
+            {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 void RadialMotif::setupRadialTransform()
@@ -55,6 +55,8 @@ public:
     virtual QString getMotifDesc()   override   { return "RadialMotif"; }
     virtual void    dump()           override   {};
 
+    virtual void    writeMapKey(QDataStream & ds) override;
+
 protected:
     RadialMotif(int n);
     RadialMotif(const Motif & motif, int n);
@@ -64,6 +66,9 @@ protected:
 
     void            setupRadialTransform();     // Transform for eachradial popint/branch
     virtual void    replicate();
+    bool            fetchMotifMap(const QByteArray & cacheKey);
+    void            replicateSymmetric(bool rotatedUnit);
+    bool            isRotatedUnit();
 
     // data
     qreal   d;      // used by star
@@ -61,6 +61,12 @@ bool Rosette::equals(const MotifPtr other)
      return true;
 }
 
+void Rosette::writeMapKey(QDataStream & ds)
+{
+    RadialMotif::writeMapKey(ds);
+    ds << q << s;
+}
+
 void Rosette::setQ(qreal qq)
 {
     q = q_clamp(qq);
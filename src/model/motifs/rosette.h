@@ -39,6 +39,7 @@ public:
                                    << "extenders" << getExtenders().count() ; }
 
     bool    equals(const MotifPtr other) override;
+    void    writeMapKey(QDataStream & ds) override;
 
 protected:
     inline int     s_clamp(int s);
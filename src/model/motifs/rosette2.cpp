@@ -80,6 +80,12 @@ bool Rosette2::equals(const MotifPtr other)
      return true;
 }
 
+void Rosette2::writeMapKey(QDataStream & ds)
+{
+    RadialMotif::writeMapKey(ds);
+    ds << kneeX << kneeY << k << s << qint32(_tipMode) << tipTypes << constrain;
+}
+
 bool Rosette2::pointOnLineLessThan(QPointF p1, QPointF p2)
 {
     return  Geo::dist2(kneePt,p1) < Geo::dist2(kneePt,p2);
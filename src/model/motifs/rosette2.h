@@ -68,6 +68,8 @@ public:
                                             << "extenders" << getExtenders().count() ; }
 
     bool    equals(const MotifPtr other) override;
+    bool    canCacheMap() override  { return !constrain; }  // converting reads the knee of a build
+    void    writeMapKey(QDataStream & ds) override;
     bool    pointOnLineLessThan(QPointF p1, QPointF v2);
     bool    convertConstrained();
 
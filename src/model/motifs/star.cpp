@@ -55,6 +55,12 @@ bool Star::equals(const MotifPtr other)
     return true;
 }
 
+void Star::writeMapKey(QDataStream & ds)
+{
+    RadialMotif::writeMapKey(ds);
+    ds << d << s;
+}
+
 void Star::setN(int n)
 {
     qDebug() << "Star::setN()" << n;
@@ -27,6 +27,7 @@ public:
     qreal   getD()  {return d;}
 
     bool    equals(const MotifPtr other) override;
+    void    writeMapKey(QDataStream & ds) override;
 
     virtual QString getMotifDesc() override { return "Star"; }
     void    dump()  override { qDebug().noquote() << getMotifDesc() << "sides:" << getN() << "d:" << d << "s" << s
@@ -54,6 +54,12 @@ bool Star2::equals(const MotifPtr other)
     return true;
 }
 
+void Star2::writeMapKey(QDataStream & ds)
+{
+    RadialMotif::writeMapKey(ds);
+    ds << theta << s;
+}
+
 void Star2::buildUnitMap()
 {
     // int s = number of intersects, qreal theta  = angle
@@ -24,6 +24,7 @@ public:
     qreal   getTheta()              {return theta; }
 
     bool    equals(const MotifPtr other) override;
+    void    writeMapKey(QDataStream & ds) override;
 
     virtual QString getMotifDesc() override { return "Star2"; }
 
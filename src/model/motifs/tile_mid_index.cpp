@@ -0,0 +1,256 @@
+#include <QDebug>
+#include <QMutexLocker>
+#include <QtMath>
+
+#include "model/motifs/tile_mid_index.h"
+#include "model/motifs/irregular_tools.h"
+#include "model/tilings/placed_tile.h"
+#include "model/tilings/tile.h"
+#include "model/tilings/tiling.h"
+#include "sys/geometry/edge_poly.h"
+#include "sys/geometry/geo.h"
+#include "sys/geometry/loose.h"
+
+using std::make_shared;
+
+TileMidIndex::TileMidIndex(TilingPtr tiling)
+{
+    wTiling   = tiling;
+    unitCount = tiling->unit().numIncluded();
+    trans1    = tiling->hdr().getTrans1();
+    trans2    = tiling->hdr().getTrans2();
+
+    // I'm going to generate all the tiles in the translational units
+    // (x,y) where -1 <= x, y <= 1.  This is guaranteed to surround
+    // every tile in the (0,0) unit by tiles.  You can then get
+    // a sense of what other tiles surround a tile on every edge.
+    qreal   edgeLen = 0.0;
+    quint64 seq     = 0;
+    const PlacedTiles tilingUnit = tiling->unit().getIncluded();
+    for( int y = -1; y <= 1; ++y )
+    {
+        for( int x = -1; x <= 1; ++x )
+        {
+            // Building a 3x3 tiling of the prototype.
+            // Create placed_points instances for all the tiles in the nine translational units
+            QPointF pt   = (trans1 * static_cast<qreal>(x)) + (trans2 * static_cast<qreal>(y));
+            QTransform T = QTransform::fromTranslate(pt.x(),pt.y());
+
+            for (const auto & placedTile : std::as_const(tilingUnit))
+            {
+                QTransform Tf   = placedTile->getPlacement() * T;
+                TilePtr tile    = placedTile->getTile();
+
+                QPolygonF t_pts = Tf.map(tile->getPoints());
+                EdgePoly t_ep   = tile->getEdgePoly().map(Tf);
+
+                Points tileMidpoints;
+                int sz = tile->numPoints();
+                for(int idx = 0; idx < sz; ++idx )
+                {
+                    QPointF a = t_pts[idx];
+                    QPointF b = t_pts[(idx+1)%sz];
+                    tileMidpoints << Geo::convexSum(a, b, 0.5 );
+                    edgeLen += QLineF(a,b).length();
+
+                    IndexedMid im;
+                    im.pt  = tileMidpoints.last();
+                    im.idx = allMotifMids.size();
+                    im.seq = seq++;
+                    allMids.push_back(im);
+                }
+
+                allMotifMids << make_shared<TileMidPoints>(make_shared<PlacedTile>(tile,Tf), tileMidpoints, t_ep);
+            }
+        }
+    }
+
+    cellSize = (allMids.isEmpty()) ? 1.0 : edgeLen / allMids.size();
+    if (cellSize <= 0.0)
+    {
+        cellSize = 1.0;
+    }
+
+    for (const IndexedMid & im : std::as_const(allMids))
+    {
+        cells[cellKey(im.pt)].push_back(im);
+    }
+}
+
+// The tiling can be edited in place, so the unit is compared as well
+bool TileMidIndex::isFor(const TilingPtr & tiling) const
+{
+    if (wTiling.lock() != tiling)
+    {
+        return false;
+    }
+    return (tiling->unit().numIncluded() == unitCount
+            && tiling->hdr().getTrans1() == trans1
+            && tiling->hdr().getTrans2() == trans2);
+}
+
+// Choose an appropriate transform of the tile to infer, i.e.
+// one that is surrounded by other tiles.  That means that we
+// should just find an instance of that tile in the (0,0) unit.
+int TileMidIndex::primaryTile(const TilePtr & tile, bool debug)
+{
+    {
+        QMutexLocker locker(&mutex);
+        auto it = primaries.constFind(tile.get());
+        if (it != primaries.constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    // The start and end of the tiles in the (0,0) unit.
+    int start = unitCount * 4;
+    int end   = unitCount * 5;
+    int cur_reg_count = -1;
+    int cur           = -1;
+
+    for( int idx = start; idx < end && idx < allMotifMids.size(); ++idx )
+    {
+        MidsPtr pp = allMotifMids[idx];
+
+        if (pp->getTile() == tile)
+        {
+            // Count the number of regular tiles surrounding this one,
+            // in the case a tile is not always surrounded by the same
+            // tiles, we want to select the one with teh most regulars.
+            QVector<AdjacentTilePtr> adjs = adjacentTiles(idx, debug);
+            if ( adjs.isEmpty() )
+            {
+                continue;
+            }
+
+            int new_reg_count = 0;
+            for ( int i = 0; i < adjs.size(); i++ )
+            {
+                if ( adjs[i] != nullptr )
+                {
+                    if ( adjs[i]->placedTile->getTile()->isRegular() )
+                    {
+                        new_reg_count++;
+                    }
+                }
+            }
+            if ( new_reg_count > cur_reg_count )
+            {
+                cur_reg_count = new_reg_count;
+                cur = idx;
+            }
+        }
+    }
+
+    if( cur == -1 )
+    {
+        qWarning("Couldn't find tile in (0,0) unit!");
+        cur = 0;
+    }
+
+    qDebug() << "Primary tile index =" << cur;
+
+    QMutexLocker locker(&mutex);
+    primaries.insert(tile.get(),cur);
+    return cur;
+}
+
+QVector<AdjacentTilePtr> TileMidIndex::adjacentTiles(int main_idx, bool debug)
+{
+    {
+        QMutexLocker locker(&mutex);
+        auto it = adjacencies.constFind(main_idx);
+        if (it != adjacencies.constEnd())
+        {
+            return it.value();
+        }
+    }
+
+    QVector<AdjacentTilePtr> ret;
+    const QVector<QPointF> & mid_points  = allMotifMids[main_idx]->getTileMidPoints();
+    for (auto & pt : std::as_const(mid_points))
+    {
+        AdjacentTilePtr ai = adjacency(pt, main_idx, debug);
+        if (ai)
+        {
+            ret.push_back(ai);
+        }
+    }
+
+    QMutexLocker locker(&mutex);
+    adjacencies.insert(main_idx,ret);
+    return ret;
+}
+
+// For this edge of the tile being inferred, find the edges of neighbouring tiles.
+// The tolerance is widened step by step, and the first midpoint in scan order
+// within the smallest tolerance which finds any is taken.
+AdjacentTilePtr TileMidIndex::adjacency(QPointF main_point, int main_idx, bool debug) const
+{
+    if (debug) qDebug() << "Searching for adjacency for " << main_point;
+
+    AdjacentTilePtr ap;
+    qreal tolerance = 1e-12;
+    while (tolerance < 5.0)
+    {
+        qreal   radius = qSqrt(tolerance);
+        CellKey lo     = cellKey(main_point - QPointF(radius,radius));
+        CellKey hi     = cellKey(main_point + QPointF(radius,radius));
+        qint64  span   = (hi.first - lo.first + 1) * (hi.second - lo.second + 1);
+
+        const IndexedMid * best = nullptr;
+        auto consider = [&](const IndexedMid & im)
+        {
+            if (im.idx != main_idx && Loose::Near(im.pt, main_point, tolerance))
+            {
+                if (!best || im.seq < best->seq)
+                {
+                    best = &im;
+                }
+            }
+        };
+
+        if (span > allMids.size())
+        {
+            // wider than the tiling, so no better than a scan
+            for (const IndexedMid & im : std::as_const(allMids))
+            {
+                consider(im);
+            }
+        }
+        else
+        {
+            for (qint64 x = lo.first; x <= hi.first; x++)
+            {
+                for (qint64 y = lo.second; y <= hi.second; y++)
+                {
+                    auto cit = cells.constFind(CellKey(x,y));
+                    if (cit == cells.constEnd())
+                    {
+                        continue;
+                    }
+                    for (const IndexedMid & im : std::as_const(cit.value()))
+                    {
+                        consider(im);
+                    }
+                }
+            }
+        }
+
+        if (best)
+        {
+            if (debug) qDebug() << "Found with tolerance " << tolerance ;
+            ap = make_shared<AdjacenctTile>(allMotifMids[best->idx]->getPlacedTile(), tolerance);
+            return ap;
+        }
+        tolerance *= 2;
+    }
+    return ap;
+}
+
+TileMidIndex::CellKey TileMidIndex::cellKey(const QPointF & pt) const
+{
+    return CellKey(static_cast<qint64>(std::floor(pt.x() / cellSize)),
+                   static_cast<qint64>(std::floor(pt.y() / cellSize)));
+}
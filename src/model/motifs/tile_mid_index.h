@@ -0,0 +1,76 @@
+#pragma once
+#ifndef TILE_MID_INDEX_H
+#define TILE_MID_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// The placed tiles around the (0,0) unit of a tiling, indexed by the
+// midpoints of their edges.
+//
+// Inference looks for the tile on the other side of each edge of the tile
+// being inferred.  The tiles of the nine translational units (x,y), where
+// -1 <= x, y <= 1, surround every tile of the (0,0) unit, and since the
+// tilings are edge to edge an edge is identified by its midpoint.
+//
+// The midpoints are bucketed into square cells about an edge long, so a
+// search only visits the cells within its tolerance.  Each entry carries
+// the order of the scan the search replaces, so the same neighbour wins
+// when more than one is in reach.  The primary tiles and their adjacencies
+// only depend on the tiling, so they are kept for every inferred motif of
+// the prototype that owns the index.
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QPointF>
+#include <QVector>
+
+typedef std::shared_ptr<class Tile>             TilePtr;
+typedef std::shared_ptr<class Tiling>           TilingPtr;
+typedef std::weak_ptr<class Tiling>             WeakTilingPtr;
+typedef std::shared_ptr<class TileMidPoints>    MidsPtr;
+typedef std::shared_ptr<class AdjacenctTile>    AdjacentTilePtr;
+typedef std::shared_ptr<class TileMidIndex>     TileMidIndexPtr;
+
+class TileMidIndex
+{
+public:
+    TileMidIndex(TilingPtr tiling);
+
+    bool                     isFor(const TilingPtr & tiling) const;
+
+    const QVector<MidsPtr> & getMids() const    { return allMotifMids; }
+    int                      primaryTile(const TilePtr & tile, bool debug = false);
+    QVector<AdjacentTilePtr> adjacentTiles(int main_idx, bool debug = false);
+    AdjacentTilePtr          adjacency(QPointF main_point, int main_idx, bool debug = false) const;
+
+protected:
+    typedef QPair<qint64,qint64> CellKey;
+
+    class IndexedMid
+    {
+    public:
+        QPointF     pt;
+        int         idx;        // into allMotifMids
+        quint64     seq;        // tile major, then edge
+    };
+
+    CellKey     cellKey(const QPointF & pt) const;
+
+private:
+    WeakTilingPtr                       wTiling;
+    int                                 unitCount;  // tiles in each translational unit
+    QPointF                             trans1;
+    QPointF                             trans2;
+
+    QVector<MidsPtr>                    allMotifMids;
+    QVector<IndexedMid>                 allMids;    // in scan order
+    QHash<CellKey,QVector<IndexedMid>>  cells;
+    qreal                               cellSize;
+
+    QMutex                              mutex;      // guards the results below
+    QHash<const Tile*,int>              primaries;
+    QHash<int,QVector<AdjacentTilePtr>> adjacencies;
+};
+
+#endif
@@ -0,0 +1,212 @@
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "model/prototypes/proto_map_cache.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/map.h"
+#include "sys/geometry/map_arena.h"
+#include "sys/geometry/vertex.h"
+
+using std::make_shared;
+
+QString ProtoMapCache::cacheDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/protomaps/";
+}
+
+QString ProtoMapCache::cacheName(const QByteArray & key)
+{
+    return cacheDir() + QString::fromLatin1(key) + ".pmc";
+}
+
+bool ProtoMapCache::load(const QByteArray & key, MapPtr map)
+{
+    Q_ASSERT(map->isEmpty());
+
+    QFile file(cacheName(key));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;       // not cached
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint64 magic   = 0;
+    qint64  version = 0;
+    in >> magic >> version;
+    if (magic != PROTO_CACHE_MAGIC || version != PROTO_CACHE_VERSION)
+    {
+        qWarning() << "invalid proto map cache entry" << file.fileName();
+        return false;
+    }
+
+    if (!readMap(in,map.get()))
+    {
+        qWarning() << "corrupt proto map cache entry" << file.fileName();
+        map->wipeout();
+        return false;
+    }
+
+    // the modification time orders the entries for trim()
+    file.close();
+    if (file.open(QIODevice::ReadWrite))
+    {
+        file.setFileTime(QDateTime::currentDateTime(),QFileDevice::FileModificationTime);
+    }
+    return true;
+}
+
+bool ProtoMapCache::save(const QByteArray & key, const MapPtr & map)
+{
+    if (!QDir().mkpath(cacheDir()))
+    {
+        qWarning() << "could not create" << cacheDir();
+        return false;
+    }
+
+    // written to a temporary and renamed, so concurrent generators
+    // never read a partial entry
+    QSaveFile file(cacheName(key));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "could not open" << file.fileName();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint64(PROTO_CACHE_MAGIC) << qint64(PROTO_CACHE_VERSION);
+    writeMap(out,map.get());
+
+    if (!file.commit())
+    {
+        return false;
+    }
+    trim();
+    return true;
+}
+
+// Removes the least recently used entries until the cache fits
+void ProtoMapCache::trim()
+{
+    QDir dir(cacheDir());
+    const QFileInfoList entries = dir.entryInfoList(QStringList("*.pmc"),QDir::Files,QDir::Time);    // newest first
+
+    qint64 total   = 0;
+    int    removed = 0;
+    for (const auto & entry : entries)
+    {
+        total += entry.size();
+        if (total > PROTO_CACHE_MAX_BYTES)
+        {
+            dir.remove(entry.fileName());
+            removed++;
+        }
+    }
+    if (removed)
+    {
+        qDebug() << "Trimmed" << removed << "proto map cache entries";
+    }
+}
+
+void ProtoMapCache::clear()
+{
+    QDir dir(cacheDir());
+    const QStringList entries = dir.entryList(QStringList("*.pmc"),QDir::Files);
+    for (const auto & name : entries)
+    {
+        dir.remove(name);
+    }
+    qInfo() << "Cleared" << entries.size() << "proto map cache entries";
+}
+
+void ProtoMapCache::writeMap(QDataStream & out, Map * map)
+{
+    const QVector<VertexPtr> & vertices = map->getVertices();
+    const EdgeSet            & edges    = map->getEdges();
+
+    QHash<const Vertex*,qint32> index;
+    index.reserve(vertices.size());
+
+    out << qint32(vertices.size());
+    for (const auto & v : vertices)
+    {
+        index.insert(v.get(),index.size());
+        out << v->pt;
+    }
+
+    out << qint32(edges.size());
+    for (const auto & e : edges)
+    {
+        out << index.value(e->v1.get(),-1) << index.value(e->v2.get(),-1);
+        if (e->isCurve())
+        {
+            out << quint8(EDGETYPE_CURVE) << e->getArcCenter() << quint8(e->getCurveType());
+        }
+        else
+        {
+            out << quint8(EDGETYPE_LINE);
+        }
+    }
+}
+
+bool ProtoMapCache::readMap(QDataStream & in, Map * map)
+{
+    qint32 numVertices = 0;
+    in >> numVertices;
+    if (in.status() != QDataStream::Ok || numVertices < 0)
+    {
+        return false;
+    }
+
+    QVector<VertexPtr> vertices;
+    vertices.reserve(numVertices);
+    for (qint32 i = 0; i < numVertices; i++)
+    {
+        QPointF pt;
+        in >> pt;
+        VertexPtr v = makeArenaShared<Vertex>(pt);
+        vertices.push_back(v);
+        map->XmlInsertDirect(v);
+    }
+
+    qint32 numEdges = 0;
+    in >> numEdges;
+    if (in.status() != QDataStream::Ok || numEdges < 0)
+    {
+        return false;
+    }
+
+    for (qint32 i = 0; i < numEdges; i++)
+    {
+        qint32 i1, i2;
+        quint8 type;
+        in >> i1 >> i2 >> type;
+        if (in.status() != QDataStream::Ok || i1 < 0 || i2 < 0 || i1 >= numVertices || i2 >= numVertices)
+        {
+            return false;
+        }
+
+        EdgePtr e;
+        if (type == EDGETYPE_CURVE)
+        {
+            QPointF center;
+            quint8  ctype;
+            in >> center >> ctype;
+            e = makeArenaShared<Edge>(vertices[i1],vertices[i2],center,static_cast<eCurveType>(ctype));
+        }
+        else
+        {
+            e = makeArenaShared<Edge>(vertices[i1],vertices[i2]);
+        }
+        map->XmlInsertDirect(e);
+    }
+
+    return (in.status() == QDataStream::Ok);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef PROTO_MAP_CACHE_H
+#define PROTO_MAP_CACHE_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A disk cache of finished prototype maps.
+//
+// Entries are named by a hash of everything the map is built from, so an
+// entry is never stale: a changed tiling, motif, fill, crop or cleanse
+// setting gives a different name.  The hashed content and the entry
+// itself are written with the same map serialisation.  The code is not
+// part of the hash, so PROTO_CACHE_VERSION must be bumped by any change
+// to what the build produces.
+//
+// The cache is opt-in.  Once it holds more than PROTO_CACHE_MAX_BYTES the
+// least recently used entries are removed, including those of older
+// versions, which are never read again.
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QString>
+
+typedef std::shared_ptr<class Map>      MapPtr;
+
+#define PROTO_CACHE_MAGIC   0x50524F544F4D4150  // "PROTOMAP"
+#define PROTO_CACHE_VERSION 4                   // 2 colinear joins, 3 parallel cleanse, 4 radial seams
+#define PROTO_CACHE_MAX_BYTES (256LL * 1024 * 1024)
+
+class ProtoMapCache
+{
+public:
+    static bool    load(const QByteArray & key, MapPtr map);
+    static bool    save(const QByteArray & key, const MapPtr & map);
+    static void    clear();
+
+    static QString cacheDir();
+
+    static void    writeMap(QDataStream & out, Map * map);
+    static bool    readMap(QDataStream & in, Map * map);
+
+protected:
+    static QString cacheName(const QByteArray & key);
+    static void    trim();
+};
+
+#endif
@@ -1,17 +1,29 @@
+#include <QCryptographicHash>
+#include <QtConcurrentMap>
+#include <QSet>
+
 #include "gui/top/splash_screen.h"
 #include "model/makers/mosaic_maker.h"
 #include "model/mosaics/mosaic.h"
+#include "model/motifs/inferred_motif.h"
 #include "model/motifs/motif.h"
+#include "model/motifs/tile_mid_index.h"
 #include "model/prototypes/design_element.h"
+#include "model/prototypes/proto_map_cache.h"
 #include "model/prototypes/prototype.h"
 #include "model/settings/configuration.h"
 #include "model/tilings/tile.h"
 #include "model/tilings/tiling.h"
 #include "sys/geometry/crop.h"
 #include "sys/geometry/dcel.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/faces.h"
+#include "sys/geometry/flat_map.h"
 #include "sys/geometry/map.h"
+#include "sys/geometry/map_arena.h"
 #include "sys/geometry/map_cleanser.h"
 #include "sys/geometry/map_verifier.h"
+#include "sys/geometry/vertex.h"
 #include "sys/qt/timers.h"
 #include "sys/sys.h"
 
@@ -42,6 +54,11 @@ Prototype::Prototype(TilingPtr t, MosaicPtr m)
     cleanseLevel    = 0;
     distort         = false;
     cleanseSensitivity = 0;
+    mergeTime       = 0;
+    contactElements = 0;
+    flatBytes       = 0;
+    objectBytes     = 0;
+    _partialRebuild = false;
     refs++;
 }
 
@@ -55,6 +72,11 @@ Prototype::Prototype(TilingPtr t)
     cleanseLevel    = 0;
     distort         = false;
     cleanseSensitivity = 0;
+    mergeTime       = 0;
+    contactElements = 0;
+    flatBytes       = 0;
+    objectBytes     = 0;
+    _partialRebuild = false;
     refs++;
 }
 
@@ -66,6 +88,11 @@ Prototype::Prototype(MapPtr map)
     cleanseLevel   = 0;
     distort        = false;
     cleanseSensitivity = 0;
+    mergeTime      = 0;
+    contactElements = 0;
+    flatBytes      = 0;
+    objectBytes    = 0;
+    _partialRebuild = false;
     refs++;
 }
 
@@ -103,9 +130,69 @@ bool Prototype::operator==(const Prototype & other)
 
 void Prototype::wipeoutProtoMap()
 {
+    int vertices = Vertex::refs;
+    int edges    = Edge::refs;
+    int faces    = Face::refs;
+
     _DCEL.reset();                  // dcel is subordinate so must be erased too.
     _protoMap->clear();
     Q_ASSERT(_protoMap->isEmpty());
+    _elementBuilds.clear();
+    _partialRebuild = false;
+    _baseElement.reset();
+    _baseMap.reset();
+    _baseArena.reset();
+    _arena.reset();                 // freed in bulk once nothing else holds its objects
+    _tileMidIndex.reset();          // the tiling may have been edited
+
+    if (vertices != Vertex::refs || edges != Edge::refs)
+    {
+        qDebug() << "Prototype wipeout freed: vertices" << vertices - Vertex::refs << "edges" << edges - Edge::refs << "faces" << faces - Face::refs;
+    }
+}
+
+// Used when only the motif of one design element has changed.
+// The proto map is rebuilt on demand as usual, but the other elements
+// keep their motif maps from the last build, so only the changed motif
+// is built again.  A merged map cannot be taken apart again (merging
+// splits edges where elements cross), so the first rebuild for an element
+// places and merges them all, keeping a copy of the merge of the others.
+// Further edits of the same element then start from that copy, and only
+// the changed element is placed and merged.
+bool Prototype::wipeoutElementMap(const DELPtr & del)
+{
+    if (!_designElements.contains(del) || _elementBuilds.isEmpty() || !_elementBuilds.contains(del))
+    {
+        return false;
+    }
+
+    for (const auto & other : std::as_const(_designElements))
+    {
+        // inferred motifs depend on the maps of their neighbours
+        if (other->getMotif()->getMotifType() == MOTIF_TYPE_INFERRED)
+        {
+            return false;
+        }
+        if (other != del && other->getMotif() == del->getMotif())
+        {
+            return false;
+        }
+    }
+
+    if (del != _baseElement)
+    {
+        // the base map holds the old contribution of this element
+        _baseElement = del;
+        _baseMap.reset();
+        _baseArena.reset();
+    }
+
+    _DCEL.reset();
+    _protoMap->clear();
+    _elementBuilds.remove(del);
+    _partialRebuild = true;
+    _arena.reset();                 // freed once the old proto map's objects have gone
+    return true;
 }
 
 MapPtr Prototype::getProtoMap(bool splash)
@@ -136,15 +223,37 @@ void Prototype::_createProtoMap(bool splash)
     }
 
     AQElapsedTimer timer;
+    mergeTime       = 0;
+    contactElements = 0;
+    flatBytes       = 0;
+    objectBytes     = 0;
 
     qDebug() << "PROTOTYPE CONSTRUCT MAP";
     QString astring = QString("Constructing prototype map for tiling: %1").arg(_tiling->getVName().get());
     qDebug().noquote() << astring;
 
+    int vertices = Vertex::refs;
+    int edges    = Edge::refs;
+
+    if (!_arena)
+    {
+        _arena = MapArena::create();
+    }
+
     _createMap();
 
     qDebug().noquote() << "PROTOTYPE COMPLETED MAP:" << _protoMap->info();
-    qDebug().noquote() << "Prototype construction" << timer.getElapsed() << "seconds";
+    qDebug().noquote() << "Prototype construction" << timer.getElapsed() << "seconds"
+                       << "merges" << QString::number(mergeTime / 1.0e9, 'f', 3) << "seconds"
+                       << "contact merges" << QString("%1/%2").arg(contactElements).arg(_designElements.size());
+    if (flatBytes)
+    {
+        qDebug().noquote() << "Prototype flat maps" << flatBytes / 1024 << "KB"
+                           << "as objects (estimated)" << objectBytes / 1024 << "KB";
+    }
+    qDebug().noquote() << "Prototype objects: vertices" << vertices << "->" << Vertex::refs
+                       << "edges" << edges << "->" << Edge::refs
+                       << "arena" << _arena->info();
 
     if (splash && viewController->splashCanPaint())
     {
@@ -185,9 +294,25 @@ void Prototype::_createMap()
         }
     }
 
+    QByteArray cacheKey;
+    MapArena::Scope arenaScope;     // the motif maps outlive the proto map, so are not in the arena
     if (_protoMap->isEmpty() && (_designElements.size() > 0))
     {
         _buildMotifMaps();
+        arenaScope.enter(_arena.get());
+
+        if (Sys::config->protoMapCache)
+        {
+            // the key covers the distortion, crop and cleanse below
+            cacheKey = _cacheKey(fillPlacements);
+            if (ProtoMapCache::load(cacheKey,_protoMap))
+            {
+                qDebug() << "PROTOTYPE from cache" << cacheKey;
+                _elementBuilds.clear();     // no element maps to keep
+                _partialRebuild = false;
+                return;
+            }
+        }
 
         _buildPrototypeMap(fillPlacements);
 
@@ -263,6 +388,66 @@ void Prototype::_createMap()
 
     MapVerifier mv(_protoMap);
     mv.verifyAndFix(Sys::config->forceVerifyProtos);
+
+    if (!cacheKey.isEmpty() && !_protoMap->isEmpty())
+    {
+        ProtoMapCache::save(cacheKey,_protoMap);
+    }
+}
+
+// A hash of everything the finished map is built from.  The motif maps
+// stand in for the motif parameters, so they must be built first.
+QByteArray Prototype::_cacheKey(const Placements & fillPlacements)
+{
+    QByteArray data;
+    QDataStream ds(&data,QIODevice::WriteOnly);
+    ds.setVersion(QDataStream::Qt_6_0);
+
+    ds << qint64(PROTO_CACHE_VERSION);
+    ds << qint32(fillPlacements.size());
+    for (const auto & T : std::as_const(fillPlacements))
+    {
+        ds << T;
+    }
+
+    for (const auto & del : std::as_const(_designElements))
+    {
+        TilePtr tile = del->getTile();
+        for (const auto & edge : std::as_const(tile->get()))
+        {
+            ds << edge->v1->pt << edge->v2->pt << edge->isCurve();
+            if (edge->isCurve())
+                ds << edge->getArcCenter() << qint32(edge->getCurveType());
+        }
+
+        Placements tilePlacements = _tiling->unit().getPlacements(tile);
+        ds << qint32(tilePlacements.size());
+        for (const auto & T : std::as_const(tilePlacements))
+        {
+            ds << T;
+        }
+
+        MapPtr motifMap = del->getMotif()->getExistingMotifMap();
+        if (motifMap)
+            ProtoMapCache::writeMap(ds,motifMap.get());
+        else
+            ds << qint32(-1);
+    }
+
+    ds << distort << distortionTransform;
+    ds << cleanseLevel << cleanseSensitivity;
+    ds << Sys::config->contactMerges << Sys::config->flatProtoBuild << Sys::config->slowCleanseMapMerges << Sys::config->forceVerifyProtos;
+
+    if (_crop)
+    {
+        ds << qint32(_crop->getCropType()) << _crop->getEmbed() << _crop->getApply();
+        ds << _crop->getRect();
+        const Circle & circle = _crop->getCircle();
+        ds << circle.centre << circle.radius;
+        ds << _crop->getAPolygon().get();
+    }
+
+    return QCryptographicHash::hash(data,QCryptographicHash::Sha1).toHex();
 }
 
 void Prototype::_buildMotifMaps()
@@ -271,26 +456,104 @@ void Prototype::_buildMotifMaps()
     // So these need to be prepared before the prototype map
     // can be built
 
-    // pass 1 - build all motif maps
-    int num_inferred = 0;
-    for (auto & del : _designElements)
+    // pass 1 - build all other motif maps, these are independent
+    QVector<MotifPtr> motifs;
+    QSet<Motif*>      queued;       // a motif can be shared by several elements
+    QVector<int>      inferred;     // element indices
+    bool debugging = false;
+    for (int i = 0; i < _designElements.size(); i++)
     {
-        auto motif = del->getMotif();
-        if (motif->getMotifType() == MOTIF_TYPE_INFERRED)
-            num_inferred++;
+        if (_partialRebuild && _elementBuilds.contains(_designElements[i]))
+        {
+            const ElementRecord & record = _elementBuilds[_designElements[i]];
+            if (record.tile == _designElements[i]->getTile() && !record.motifMap.expired())
+                continue;   // unchanged since the last build
+        }
+
+        auto motif = _designElements[i]->getMotif();
         motif->cleanExtenders();
-        motif->buildMotifMap();
+        if (motif->getMotifType() == MOTIF_TYPE_INFERRED)
+            inferred.push_back(i);
+        else if (!queued.contains(motif.get()))
+        {
+            queued.insert(motif.get());
+            motifs.push_back(motif);
+        }
+        if (motif->getMotifDebug())
+            debugging = true;       // the debug map is shared
+    }
+
+    if (Sys::config->parallelProtoBuild && !debugging && motifs.size() > 1)
+    {
+        QtConcurrent::blockingMap(motifs, [](MotifPtr & motif) { motif->buildMotifMap(); });
+    }
+    else
+    {
+        for (auto & motif : motifs)
+        {
+            motif->buildMotifMap();
+        }
+    }
+
+    if (inferred.isEmpty())
+        return;
+
+    // pass 2 - build InferredMotifs after the inferred motifs next to them.
+    // Inferences read the maps of their neighbours and the source maps
+    // are written while being copied, so these are built one at a time.
+    QMap<int,QVector<int>> dependsOn;   // inferred element -> inferred elements
+    for (int i : std::as_const(inferred))
+    {
+        auto infer = std::dynamic_pointer_cast<InferredMotif>(_designElements[i]->getMotif());
+        QVector<TilePtr> tiles;
+        if (infer)
+            tiles = infer->getAdjacentTiles();
+        for (int j : std::as_const(inferred))
+        {
+            if (j != i && tiles.contains(_designElements[j]->getTile()))
+                dependsOn[i].push_back(j);
+        }
     }
 
-    // pass 2 - rebuild InferredMotifs
-    for (int i=0; i < num_inferred; i++)
+    // build in dependency order, taking ready motifs in element order
+    QVector<int> remaining = inferred;
+    bool progress = true;
+    while (progress && !remaining.isEmpty())
     {
-        for (const auto & del : std::as_const(_designElements))
+        progress = false;
+        for (int k = 0; k < remaining.size(); k++)
         {
-            auto motif = del->getMotif();
-            if (motif->getMotifType() == MOTIF_TYPE_INFERRED)
+            int i = remaining[k];
+            bool ready = true;
+            for (int j : std::as_const(dependsOn[i]))
             {
-                motif->buildMotifMap();
+                if (remaining.contains(j))
+                {
+                    ready = false;
+                    break;
+                }
+            }
+            if (ready)
+            {
+                _designElements[i]->getMotif()->buildMotifMap();
+                remaining.removeAt(k);
+                progress = true;
+                break;
+            }
+        }
+    }
+
+    // Mutually dependent inferences have no settled order, so the
+    // sweeps of the original scheme are kept for them: one build
+    // plus one sweep per inferred motif.
+    if (!remaining.isEmpty())
+    {
+        qDebug() << "Prototype: mutually dependent inferred motifs" << remaining.size();
+        for (int sweep = 0; sweep <= remaining.size(); sweep++)
+        {
+            for (int i : std::as_const(remaining))
+            {
+                _designElements[i]->getMotif()->buildMotifMap();
             }
         }
     }
@@ -298,29 +561,201 @@ void Prototype::_buildMotifMaps()
 
 void Prototype::_buildPrototypeMap(Placements & fillPlacements)
 {
+    QElapsedTimer timer;
+    timer.start();
+
+    // Tiles in a tiling without intrinsic overlaps only meet along their
+    // edges, so copies of a motif which stays within its tile can be merged
+    // without testing every edge against every other copy
+    bool contact = Sys::config->contactMerges && !_tiling->hasIntrinsicOverlaps();
+    bool flat    = Sys::config->flatProtoBuild;
+
+    // A rebuild of the element left out of the base map only builds that element
+    bool keepBase = _partialRebuild && _baseElement && _designElements.contains(_baseElement);
+    bool fromBase = keepBase && _baseMap;
+
+    // gather the inputs here, motif maps are built on demand
+    QVector<ElementBuild> builds;
+    builds.reserve(_designElements.size());
+    bool shared = false;
     for (auto & designElement : _designElements)
     {
-        TilePtr tile              = designElement->getTile();
-        Placements tilePlacements = _tiling->unit().getPlacements(tile);
-        if (!tilePlacements.size())
-            tilePlacements.push_back(QTransform());   // dummy tilings have no placements
+        if (fromBase && designElement != _baseElement)
+            continue;
+
+        ElementBuild build;
+        build.element        = designElement;
+        build.tile           = designElement->getTile();
+        build.tilePlacements = _tiling->unit().getPlacements(build.tile);
+        if (!build.tilePlacements.size())
+            build.tilePlacements.push_back(QTransform());   // dummy tilings have no placements
 
         MotifPtr motif  = designElement->getMotif();
-        MapPtr motifMap = motif->getMotifMap();
-        if (!motifMap)
+        build.motifMap  = motif->getMotifMap();
+        if (!build.motifMap)
         {
             qWarning("empty motif map");
-            motifMap = make_shared<Map>("Kludge map");
+            build.motifMap = make_shared<Map>("Kludge map");
         }
+        build.contact     = false;
+        build.flatBytes   = 0;
+        build.objectBytes = 0;
 
-        MapPtr unitMap =  make_shared<Map>("proto unit map");
-        unitMap->mergeMany(motifMap, tilePlacements);
+        // merging writes the copy links into the source map's vertices
+        for (const auto & other : std::as_const(builds))
+        {
+            if (other.motifMap == build.motifMap)
+                shared = true;
+        }
+        builds.push_back(build);
+    }
 
-        MapPtr tileMap = make_shared<Map>("proto tile map");
-        tileMap->mergeMany(unitMap, fillPlacements);
+    // Each element's tile map only depends on its own motif map, so they
+    // are built concurrently unless two elements share a motif map.
+    // The reduction below is always in element order, so the result is
+    // the same as the serial build.
+    // The element maps are temporaries, merged into the proto map below, so
+    // they get an arena of their own which goes when they do
+    MapArenaPtr scratch = MapArena::create();
+    if (Sys::config->parallelProtoBuild && !shared && builds.size() > 1)
+    {
+        MapArena * arena = scratch.get();
+        QtConcurrent::blockingMap(builds, [&fillPlacements, contact, flat, arena](ElementBuild & build)
+                                  { MapArena::Scope scope(arena);
+                                    _buildElementMap(build, fillPlacements, contact, flat); });
+    }
+    else
+    {
+        MapArena::Scope scope(scratch.get());
+        for (auto & build : builds)
+        {
+            _buildElementMap(build, fillPlacements, contact, flat);
+        }
+    }
+
+    if (fromBase)
+    {
+        _protoMap = _baseMap->recreate();   // into the proto map's arena
+        _protoMap->mname = "ProtoMap ";
+    }
+    else
+    {
+        _elementBuilds.clear();
+    }
 
-        _protoMap->mergeMap(tileMap);
+    // only the inputs are kept, the tile maps go once they are merged.
+    // The element left out of the base map is merged last.
+    ElementBuild * edited = nullptr;
+    for (auto & build : builds)
+    {
+        if (keepBase && !fromBase && build.element == _baseElement)
+        {
+            edited = &build;
+            continue;
+        }
+        _mergeElementMap(build);
+    }
+    if (edited)
+    {
+        // the base map outlives the proto map, so has an arena of its own
+        _baseArena = MapArena::create();
+        {
+            MapArena::Scope scope(_baseArena.get());
+            _baseMap = _protoMap->recreate();
+        }
+        _mergeElementMap(*edited);
     }
+    builds.clear();
+    scratch.reset();
+    _partialRebuild = false;
+
+    mergeTime = timer.nsecsElapsed();
+}
+
+void Prototype::_mergeElementMap(ElementBuild & build)
+{
+    _protoMap->mergeMap(build.tileMap);
+    build.tileMap.reset();
+    if (build.contact)
+        contactElements++;
+    flatBytes   += build.flatBytes;
+    objectBytes += build.objectBytes;
+
+    ElementRecord record;
+    record.tile     = build.tile;
+    record.motifMap = build.motifMap;
+    _elementBuilds.insert(build.element,record);
+}
+
+void Prototype::_buildElementMap(ElementBuild & build, const Placements & fillPlacements, bool useContact, bool useFlat)
+{
+    MapPtr unitMap  = make_shared<Map>("proto unit map");
+    build.tileMap   = make_shared<Map>("proto tile map");
+    build.contact   = useContact && _canContactMerge(build.tile,build.motifMap);
+
+    if (build.contact && useFlat)
+    {
+        // The copies are replicated as flat arrays and only the finished
+        // tile map is made into Vertex and Edge objects.  The seam edges
+        // are welded and split once, in the tile map.
+        QVector<QPolygonF> tileBounds;
+        tileBounds.push_back(build.tile->getPoints());
+        FlatMap motif = FlatMap::fromMap(build.motifMap.get(), tileBounds);
+
+        FlatMap unit;
+        unit.reserve(motif.numVertices() * build.tilePlacements.size(), motif.numEdges() * build.tilePlacements.size());
+        for (const auto & T : std::as_const(build.tilePlacements))
+        {
+            unit.appendTransformed(motif,T);
+        }
+
+        FlatMap tile;
+        tile.reserve(unit.numVertices() * fillPlacements.size(), unit.numEdges() * fillPlacements.size());
+        for (const auto & T : std::as_const(fillPlacements))
+        {
+            tile.appendTransformed(unit,T);
+        }
+
+        build.tileMap->mergeFlat(tile);
+
+        build.flatBytes   = motif.memoryBytes() + unit.memoryBytes() + tile.memoryBytes();
+        build.objectBytes = FlatMap::estimateObjectBytes(unit.numVertices(),unit.numEdges())
+                          + FlatMap::estimateObjectBytes(tile.numVertices(),tile.numEdges());
+    }
+    else if (build.contact)
+    {
+        QPolygonF tilePoly = build.tile->getPoints();
+
+        QVector<QPolygonF> tileBounds;
+        tileBounds.push_back(tilePoly);
+        unitMap->mergeContactMany(build.motifMap, build.tilePlacements, tileBounds);
+
+        QVector<QPolygonF> unitBounds;
+        for (const auto & T : std::as_const(build.tilePlacements))
+        {
+            unitBounds.push_back(T.map(tilePoly));
+        }
+        build.tileMap->mergeContactMany(unitMap, fillPlacements, unitBounds);
+    }
+    else
+    {
+        unitMap->mergeMany(build.motifMap, build.tilePlacements);
+        build.tileMap->mergeMany(unitMap, fillPlacements);
+    }
+}
+
+// The fast path needs a straight edged tile and a motif map which does
+// not stray outside it.  Anything else takes the full merge.
+bool Prototype::_canContactMerge(const TilePtr & tile, const MapPtr & motifMap)
+{
+    for (const auto & edge : std::as_const(tile->get()))
+    {
+        if (edge->isCurve())
+        {
+            return false;
+        }
+    }
+    return motifMap->liesWithin(tile->getPoints());
 }
 
 const DCELPtr & Prototype::getDCEL()
@@ -330,6 +765,7 @@ const DCELPtr & Prototype::getDCEL()
         QMutexLocker locker(&dcelMutex);
 
         auto protomap = getProtoMap();
+        MapArena::Scope arenaScope(_arena.get());   // the faces go with the proto map
         auto dcel     = std::make_shared<DCEL>(protomap.get());
         if (dcel->build())
         {
@@ -351,7 +787,7 @@ void Prototype::replaceTiling(const TilingPtr & newTiling)
 
     _tiling = newTiling;
 
-    _protoMap->clear();
+    wipeoutProtoMap();
 
     QVector<TilePtr>          unusedTiles;
     QVector<DELPtr> usedElements;
@@ -410,7 +846,7 @@ void Prototype::exactReplaceTiling(const TilingPtr & newTiling)
     // exact replacement of tiling where tiles match
     _tiling = newTiling;
 
-    _protoMap->clear();
+    wipeoutProtoMap();
 
     QVector<DELPtr> usedElements;
 
@@ -526,6 +962,21 @@ MotifPtr Prototype::getMotif(const TilePtr & tile)
     return f;
 }
 
+// nullptr for a prototype without a tiling
+TileMidIndexPtr Prototype::getTileMidIndex()
+{
+    if (!_tiling)
+    {
+        _tileMidIndex.reset();
+        return _tileMidIndex;
+    }
+    if (!_tileMidIndex || !_tileMidIndex->isFor(_tiling))
+    {
+        _tileMidIndex = std::make_shared<TileMidIndex>(_tiling);
+    }
+    return _tileMidIndex;
+}
+
 QList<TilePtr> Prototype::getTiles()
 {
     QList<TilePtr> ql;
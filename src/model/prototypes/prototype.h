@@ -2,11 +2,14 @@
 #ifndef PROTOTYPE_H
 #define PROTOTYPE_H
 
+#include <QByteArray>
 #include <QString>
 #include <QTransform>
+#include <QMap>
 #include <QMutex>
 #include <QMetaType>
 #include <QDebug>
+#include <QVector>
 
 #include "sys/geometry/fill_region.h"
 
@@ -14,7 +17,9 @@ typedef std::shared_ptr<class Crop>             CropPtr;
 typedef std::shared_ptr<class DCEL>             DCELPtr;
 typedef std::shared_ptr<class Tiling>           TilingPtr;
 typedef std::shared_ptr<class Map>              MapPtr;
+typedef std::shared_ptr<class MapArena>         MapArenaPtr;
 typedef std::shared_ptr<class Tile>             TilePtr;
+typedef std::shared_ptr<class TileMidIndex>     TileMidIndexPtr;
 typedef std::shared_ptr<class Mosaic>           MosaicPtr;
 typedef std::shared_ptr<class Motif>            MotifPtr;
 typedef std::shared_ptr<class DesignElement>    DELPtr;
@@ -23,6 +28,7 @@ typedef std::shared_ptr<class Prototype>        ProtoPtr;
 typedef std::weak_ptr<class Prototype>          WeakProtoPtr;
 typedef std::weak_ptr<class Mosaic>             WeakMosaicPtr;
 typedef std::weak_ptr<class Tiling>             WeakTilingPtr;
+typedef std::weak_ptr<class Map>                WeakMapPtr;
 
 Q_DECLARE_METATYPE(WeakProtoPtr)
 Q_DECLARE_METATYPE(WeakTilingPtr)
@@ -58,6 +64,7 @@ public:
 
     // Maps
     void            wipeoutProtoMap();
+    bool            wipeoutElementMap(const DELPtr & del);   // false if a full wipeout is needed
     MapPtr          getProtoMap(bool splash = false);       // builds on demand
     MapPtr          getExistingProtoMap()   { return _protoMap; }
     void            setProtoMap(MapPtr map) { _protoMap = map; }
@@ -83,6 +90,7 @@ public:
     QList<TilePtr>    getTiles();
     TilePtr           getTile(const MotifPtr & motif);
     MotifPtr          getMotif(const TilePtr & tile);
+    TileMidIndexPtr   getTileMidIndex();                    // builds on demand, for inferred motifs, null without a tiling
 
     // Crop
     void    setCrop(CropPtr crop);
@@ -118,6 +126,32 @@ private:
     void    _createMap();
     void    _buildMotifMaps();
     void    _buildPrototypeMap(Placements &fillPlacements);
+    QByteArray _cacheKey(const Placements & fillPlacements);
+
+    class ElementBuild
+    {
+    public:
+        DELPtr      element;
+        TilePtr     tile;
+        Placements  tilePlacements;
+        MapPtr      motifMap;
+        MapPtr      tileMap;        // result
+        bool        contact;        // result: built by contact merges
+        qint64      flatBytes;      // result: size of the flat maps, if used
+        qint64      objectBytes;    // result: estimated size of the same maps as objects
+    };
+
+    // what a partial rebuild needs of an element from the last build
+    class ElementRecord
+    {
+    public:
+        TilePtr     tile;
+        WeakMapPtr  motifMap;       // the motif owns it
+    };
+
+    void        _mergeElementMap(ElementBuild & build);
+    static void _buildElementMap(ElementBuild & build, const Placements & fillPlacements, bool useContact, bool useFlat);
+    static bool _canContactMerge(const TilePtr & tile, const MapPtr & motifMap);
 
     // prototype data
     QVector<DELPtr>             _designElements;
@@ -126,8 +160,10 @@ private:
     // derived maps
     MapPtr                      _protoMap;
     DCELPtr                     _DCEL;
+    MapArenaPtr                 _arena;             // the proto map's objects, dropped by wipeouts
 
     TilingPtr                   _tiling;            // prototypes own tilings
+    TileMidIndexPtr             _tileMidIndex;      // the tiling's tiles, shared by inferences
     WeakMosaicPtr               wMosaic;            // mosaics own prototypes, si weak pointer
     SystemViewController *      viewController;     // can be changed
 
@@ -139,6 +175,21 @@ private:
 
     bool                        distort;
     QTransform                  distortionTransform;
+
+    // build statistics
+    qint64                      mergeTime;          // nanoseconds
+    int                         contactElements;    // elements merged by the PIC fast path
+    qint64                      flatBytes;          // flat maps used by the build
+    qint64                      objectBytes;        // the same maps as Vertex/Edge objects, estimated
+
+    // the elements of the last build, for rebuilding one element
+    QMap<DELPtr,ElementRecord>  _elementBuilds;
+    bool                        _partialRebuild;
+
+    // while one element is edited, the other elements merged without it
+    DELPtr                      _baseElement;       // the element left out
+    MapPtr                      _baseMap;
+    MapArenaPtr                 _baseArena;
 };
 
 #endif
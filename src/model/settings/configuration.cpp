@@ -50,6 +50,15 @@ Configuration::Configuration()
     verifyDump          = s.value("verifyDump",false).toBool();
     verifyVerbose       = s.value("verifyVerbose",false).toBool();
     slowCleanseMapMerges = s.value("unDuplicateMerge",false).toBool();
+    contactMerges       = s.value("contactMerges",true).toBool();
+    parallelProtoBuild  = s.value("parallelProtoBuild",true).toBool();
+    protoMapCache       = s.value("protoMapCache",false).toBool();
+    flatProtoBuild      = s.value("flatProtoBuild",true).toBool();
+    parallelCleanse     = s.value("parallelCleanse",true).toBool();
+    symmetricMotifs     = s.value("symmetricMotifs",true).toBool();
+    motifMapCache       = s.value("motifMapCache",true).toBool();
+    layerImageCache     = s.value("layerImageCache",true).toBool();
+    parallelCasings     = s.value("parallelCasings",true).toBool();
     buildEmptyNmaps     = s.value("buildEmptyNmaps",false).toBool();
     baseLogName         = s.value("baseLogName","tiledPatternMakerLog").toString();
     logToStderr         = s.value("logToStderr",true).toBool();
@@ -225,6 +234,15 @@ void Configuration::save()
     s.setValue("verifyDump",verifyDump);
     s.setValue("verifyVerbose",verifyVerbose);
     s.setValue("unDuplicateMerge",slowCleanseMapMerges);
+    s.setValue("contactMerges",contactMerges);
+    s.setValue("parallelProtoBuild",parallelProtoBuild);
+    s.setValue("protoMapCache",protoMapCache);
+    s.setValue("flatProtoBuild",flatProtoBuild);
+    s.setValue("parallelCleanse",parallelCleanse);
+    s.setValue("symmetricMotifs",symmetricMotifs);
+    s.setValue("motifMapCache",motifMapCache);
+    s.setValue("layerImageCache",layerImageCache);
+    s.setValue("parallelCasings",parallelCasings);
     s.setValue("buildEmptyNmaps",buildEmptyNmaps);
     s.setValue("baseLogName",baseLogName);
     s.setValue("logToStderr",logToStderr);
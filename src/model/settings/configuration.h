@@ -174,6 +174,15 @@ public:
     bool    verifyVerbose;      // TODO - make sure this flag work
     bool    buildEmptyNmaps;    // rebuild empty neighbour maps
     bool    slowCleanseMapMerges;   // de-duplicates edges after merge
+    bool    contactMerges;          // simple merges for tilings without overlaps
+    bool    parallelProtoBuild;     // builds motif and design element maps concurrently
+    bool    protoMapCache;          // keeps finished prototype maps on disk
+    bool    flatProtoBuild;         // replicates contact merged elements as flat maps
+    bool    parallelCleanse;        // finds map intersections concurrently
+    bool    symmetricMotifs;        // replicates radial units by welding their seams
+    bool    motifMapCache;          // shares built motif maps between equal motifs
+    bool    layerImageCache;        // blits unchanged style layers from an image
+    bool    parallelCasings;        // builds outline and interlace casings concurrently
 
     bool    mosaicFilterCheck;
     bool    mosaicWorklistCheck;
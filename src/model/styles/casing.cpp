@@ -50,7 +50,24 @@ void Casing::createCurved()
     s2->created =  true;
 }
 
+// Aligning a side moves its corners and the corners of the neighbours
+// they join.  The moves are found first and then applied, so that the
+// casings can also be aligned in chunks by CasingSet::alignCurves().
 void Casing::alignCurvedEdgeSide1(CasingSet &casings)
+{
+    CasingMoves moves;
+    findCurvedEdgeSide1(casings,moves);
+    CasingSet::applyMoves(moves);
+}
+
+void Casing::alignCurvedEdgeSide2(CasingSet &casings)
+{
+    CasingMoves moves;
+    findCurvedEdgeSide2(casings,moves);
+    CasingSet::applyMoves(moves);
+}
+
+void Casing::findCurvedEdgeSide1(CasingSet &casings, CasingMoves & moves)
 {
     auto edge = wedge.lock();
     if (!edge)
@@ -86,8 +103,8 @@ void Casing::alignCurvedEdgeSide1(CasingSet &casings)
 
     if (rv)
     {
-        s1->inner   = p;
-        *otherPoint = p;
+        moves.push_back(CasingMove(&s1->inner,p));
+        moves.push_back(CasingMove(otherPoint,p));
     }
     else
         qWarning() << "s1 inner - no isect";
@@ -108,14 +125,14 @@ void Casing::alignCurvedEdgeSide1(CasingSet &casings)
 
     if (rv)
     {
-        s1->outer   = p;
-        *otherPoint = p;
+        moves.push_back(CasingMove(&s1->outer,p));
+        moves.push_back(CasingMove(otherPoint,p));
     }
     else
         qWarning() << "s1 outer - no isect";
 }
 
-void Casing::alignCurvedEdgeSide2(CasingSet &casings)
+void Casing::findCurvedEdgeSide2(CasingSet &casings, CasingMoves & moves)
 {
     auto edge = wedge.lock();
     if (!edge)
@@ -153,8 +170,8 @@ void Casing::alignCurvedEdgeSide2(CasingSet &casings)
 
     if (rv)
     {
-        s2->inner   = p;
-        *otherPoint = p;
+        moves.push_back(CasingMove(&s2->inner,p));
+        moves.push_back(CasingMove(otherPoint,p));
     }
     else
         qWarning() << "s2 inner - no isect";
@@ -175,8 +192,8 @@ void Casing::alignCurvedEdgeSide2(CasingSet &casings)
 
     if (rv)
     {
-        s2->outer   = p;
-        *otherPoint = p;
+        moves.push_back(CasingMove(&s2->outer,p));
+        moves.push_back(CasingMove(otherPoint,p));
     }
     else
         qWarning() << "s2 inner - no isect";
@@ -207,6 +224,34 @@ void Casing::drawOutline(GeoGraphics *gg, QPen & pen) const
     }
 }
 
+// The lines of drawOutline() as one path, for styles which cache them
+QPainterPath Casing::getOutlinePath() const
+{
+    QPainterPath opath;
+
+    auto edge = wedge.lock();
+    if (!edge) return opath;
+
+    if (edge->getType() == EDGETYPE_LINE)
+    {
+        opath.moveTo(s1->inner);
+        opath.lineTo(s2->inner);
+        opath.moveTo(s1->outer);
+        opath.lineTo(s2->outer);
+    }
+    else if (edge->getType() == EDGETYPE_CURVE)
+    {
+        ArcData ad1(QLineF(s2->inner,s1->inner),edge->getArcCenter(),edge->getCurveType());
+        opath.arcMoveTo(ad1.rect(),ad1.start());
+        opath.arcTo(ad1.rect(),ad1.start(),-ad1.span());
+
+        ArcData ad2(QLineF(s1->outer,s2->outer),edge->getArcCenter(),edge->getCurveType());
+        opath.arcMoveTo(ad2.rect(),ad2.start());
+        opath.arcTo(ad2.rect(),ad2.start(),ad2.span());
+    }
+    return opath;
+}
+
 void Casing::addToMap(MapPtr map)
 {
     EdgePtr edge = wedge.lock();
@@ -276,6 +321,25 @@ QPolygonF Casing::getPoly() const
     return p;
 }
 
+// inner, mid and outer of side 1, then of side 2
+QPolygonF Casing::getCorners() const
+{
+    QPolygonF p;
+    p << s1->inner << s1->mid << s1->outer << s2->inner << s2->mid << s2->outer;
+    return p;
+}
+
+void Casing::setCorners(const QPolygonF & corners)
+{
+    Q_ASSERT(corners.size() == 6);
+    s1->inner = corners[0];
+    s1->mid   = corners[1];
+    s1->outer = corners[2];
+    s2->inner = corners[3];
+    s2->mid   = corners[4];
+    s2->outer = corners[5];
+}
+
 void Casing::debugDraw(QColor color, qreal width)
 {
     EdgePtr edge = wedge.lock();
@@ -15,15 +15,20 @@ class Casing
 public:
     Casing();
 
+    virtual void       init()           = 0;
     virtual void       setPainterPath() = 0;
     virtual bool       validate()       = 0;
 
     void        createCurved();
     void        alignCurvedEdgeSide1(CasingSet &casings);
     void        alignCurvedEdgeSide2(CasingSet &casings);
+    void        findCurvedEdgeSide1(CasingSet &casings, CasingMoves & moves);
+    void        findCurvedEdgeSide2(CasingSet &casings, CasingMoves & moves);
 
     void        fillCasing( GeoGraphics * gg, QPen & pen) const;
     void        drawOutline(GeoGraphics * gg, QPen & pen) const;
+    QPainterPath getOutlinePath() const;
+    const QPainterPath & getPainterPath() const { return path; }
     void        debugDraw(QColor color, qreal width);
 
     EdgePtr     getEdge()           { return wedge.lock(); }
@@ -42,6 +47,8 @@ public:
     QLineF      s1Line()            { return QLineF(s1->inner,s1->outer); }
     QLineF      s2Line()            { return QLineF(s2->inner,s2->outer); }
     QPolygonF   getPoly() const;
+    QPolygonF   getCorners() const;
+    void        setCorners(const QPolygonF & corners);
 
     bool        getCircleIsect(const Circle & circle, Casing &other, bool inner, const QPointF & oldPt, QPointF & newPt);
 
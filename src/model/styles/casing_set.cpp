@@ -1,11 +1,227 @@
+#include <QThreadPool>
+#include <QtConcurrentMap>
 #include "model/styles/casing_set.h"
 #include "model/styles/casing.h"
+#include "model/settings/configuration.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/loose.h"
+#include "sys/sys.h"
+#include "sys/sys/debugflags.h"
+
+static bool sameCorners(const QPolygonF & a, const QPolygonF & b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (int i = 0; i < a.size(); i++)
+    {
+        if (!Loose::equalsPt(a[i],b[i]))
+            return false;
+    }
+    return true;
+}
 
 CasingSet::CasingSet()
 {
     map =  std::make_shared<Map>("CasingSet");
 }
 
+// The casings are created and numbered serially.  Each init() only reads
+// its edge and the CasingNeighbours of its vertices, which are complete
+// by now, so for large maps the casings are initialised in chunks.
+void CasingSet::createCasings(const EdgeSet & edges, CasingMaker maker)
+{
+    uint index = 0;
+    for (const EdgePtr & edge : edges)
+    {
+        CasingPtr casing  = maker(edge);
+        push_back(casing);
+        casing->edgeIndex = index;
+        edge->casingIndex = index;
+        index++;
+    }
+
+    if (!inParallel())
+    {
+        for (CasingPtr & casing : *this)
+        {
+            casing->init();
+        }
+        return;
+    }
+
+    int chunkSize;
+    const QVector<int> starts = chunkStarts(chunkSize);
+    const int count = size();
+
+    QtConcurrent::blockingMap(starts, [this, count, chunkSize](const int & start)
+    {
+        int end = qMin(start + chunkSize, count);
+        for (int i = start; i < end; i++)
+        {
+            at(i)->init();
+        }
+    });
+
+    if (Sys::flags->flagged(VALIDATE))
+        verifyInit(maker);
+}
+
+// Aligning a curved casing also moves the corners of its neighbours.  In
+// chunks, the moves are found against the casings as they were before any
+// alignment, then applied serially in casing order, so where two casings
+// move the same corner the later one wins, as it does serially.  A line
+// casing only moves along its own line, so the results agree with the
+// serial alignment to within tolerance.
+void CasingSet::alignCurves()
+{
+    if (!inParallel())
+    {
+        alignSerially();
+        return;
+    }
+
+    QVector<QPolygonF> before;
+    if (Sys::flags->flagged(VALIDATE))
+        before = getCorners();
+
+    int chunkSize;
+    const QVector<int> starts = chunkStarts(chunkSize);
+    const int count = size();
+
+    QVector<CasingMoves> buffers(starts.size());
+    QtConcurrent::blockingMap(starts, [this, &buffers, count, chunkSize](const int & start)
+    {
+        CasingMoves & moves = buffers[start / chunkSize];
+        int end = qMin(start + chunkSize, count);
+        for (int i = start; i < end; i++)
+        {
+            const CasingPtr & casing = at(i);
+            auto edge = casing->getEdge();
+            if (edge && edge->isCurve())
+            {
+                casing->findCurvedEdgeSide1(*this,moves);
+                casing->findCurvedEdgeSide2(*this,moves);
+            }
+        }
+    });
+
+    for (const CasingMoves & moves : std::as_const(buffers))
+    {
+        applyMoves(moves);
+    }
+
+    if (Sys::flags->flagged(VALIDATE))
+        verifyAlignment(before);
+}
+
+void CasingSet::applyMoves(const CasingMoves & moves)
+{
+    for (const CasingMove & move : std::as_const(moves))
+    {
+        *move.pt = move.to;
+    }
+}
+
+// The debug marks made by init() are not thread safe
+bool CasingSet::inParallel() const
+{
+    return (Sys::config->parallelCasings
+            && size() >= CASING_PARALLEL_MIN
+            && !Sys::flags->flagged(MARK_JOIN));
+}
+
+QVector<int> CasingSet::chunkStarts(int & chunkSize) const
+{
+    const int count  = size();
+    const int chunks = qMin(count, QThreadPool::globalInstance()->maxThreadCount() * 4);
+    chunkSize        = (count + chunks - 1) / chunks;
+
+    QVector<int> starts;
+    for (int start = 0; start < count; start += chunkSize)
+    {
+        starts.push_back(start);
+    }
+    return starts;
+}
+
+void CasingSet::alignSerially()
+{
+    for (CasingPtr & casing : *this)
+    {
+        auto edge = casing->getEdge();
+        if (edge && edge->isCurve())
+        {
+            casing->alignCurvedEdgeSide1(*this);
+            casing->alignCurvedEdgeSide2(*this);
+        }
+    }
+}
+
+QVector<QPolygonF> CasingSet::getCorners() const
+{
+    QVector<QPolygonF> corners;
+    corners.reserve(size());
+    for (const CasingPtr & casing : std::as_const(*this))
+    {
+        corners.push_back(casing->getCorners());
+    }
+    return corners;
+}
+
+void CasingSet::setCorners(const QVector<QPolygonF> & corners)
+{
+    Q_ASSERT(corners.size() == size());
+    for (int i = 0; i < size(); i++)
+    {
+        at(i)->setCorners(corners[i]);
+    }
+}
+
+// Initialises a scratch casing serially for each edge and compares it
+// with the casing initialised in parallel
+void CasingSet::verifyInit(CasingMaker maker)
+{
+    int mismatches = 0;
+    for (int i = 0; i < size(); i++)
+    {
+        const CasingPtr & casing = at(i);
+        CasingPtr serial = maker(casing->getEdge());
+        serial->init();
+        if (!sameCorners(casing->getCorners(),serial->getCorners())
+            || casing->innerCircle != serial->innerCircle
+            || casing->outerCircle != serial->outerCircle)
+        {
+            qWarning() << "casing" << i << "parallel init differs from serial";
+            mismatches++;
+        }
+    }
+    qInfo() << "verified parallel casing init:" << size() << "casings" << mismatches << "mismatches";
+}
+
+// Repeats the alignment serially from the same start and compares it
+// with the parallel alignment, which is kept
+void CasingSet::verifyAlignment(const QVector<QPolygonF> & before)
+{
+    const QVector<QPolygonF> parallel = getCorners();
+
+    setCorners(before);
+    alignSerially();
+    const QVector<QPolygonF> serial = getCorners();
+
+    setCorners(parallel);
+
+    int mismatches = 0;
+    for (int i = 0; i < size(); i++)
+    {
+        if (!sameCorners(parallel[i],serial[i]))
+        {
+            qWarning() << "casing" << i << "parallel alignment differs from serial" << parallel[i] << serial[i];
+            mismatches++;
+        }
+    }
+    qInfo() << "verified parallel casing alignment:" << size() << "casings" << mismatches << "mismatches";
+}
+
 void CasingSet::buildMap()
 {
     map->wipeout();
@@ -29,6 +245,30 @@ void CasingSet::validate()
     qInfo() << "validating casings - end";
 }
 
+// The casings are indexed by the bounds of their painter paths, so that a
+// style zoomed in on part of the design only draws the casings in view.
+void CasingSet::indexCasings()
+{
+    QVector<QRectF> bounds;
+    bounds.reserve(size());
+    for (auto & casing : std::as_const(*this))
+    {
+        bounds.push_back(casing->getPainterPath().boundingRect());
+    }
+    drawIndex.build(bounds);
+}
+
+// false if all the casings should be drawn, including when the
+// casings have changed since they were indexed
+bool CasingSet::cull(const QRectF & view, QVector<int> & visible) const
+{
+    if (drawIndex.size() != size())
+    {
+        return false;
+    }
+    return drawIndex.cull(view,visible);
+}
+
 void CasingSet::dump(QString str)
 {
     qDebug() << "start" << str;
@@ -2,13 +2,32 @@
 #ifndef CASING_SET_H
 #define CASING_SET_H
 
+#include <functional>
+#include <QPolygonF>
 #include <QVector>
 #include "model/styles/casing_side.h"
+#include "sys/geometry/draw_index.h"
 #include "sys/geometry/map.h"
 
 typedef std::shared_ptr<class Casing> CasingPtr;
 typedef std::weak_ptr<class Casing>  wCasingPtr;
 
+typedef std::function<CasingPtr(const EdgePtr & edge)> CasingMaker;
+
+#define CASING_PARALLEL_MIN 256     // casings before they are built in chunks
+
+// A corner moved by the alignment of a curved casing
+class CasingMove
+{
+public:
+    CasingMove()                                { pt = nullptr; }
+    CasingMove(QPointF * pt, QPointF to)        { this->pt = pt; this->to = to; }
+
+    QPointF *   pt;
+    QPointF     to;
+};
+
+typedef QVector<CasingMove> CasingMoves;
 
 class CasingSet : public QVector<CasingPtr>
 {
@@ -18,14 +37,34 @@ public:
     CasingPtr find(EdgePtr &edge)   { return this->at(edge->casingIndex); }
     CNeighboursPtr   getNeighbouringCasings(VertexPtr v) { return weavings.value(v); }
 
+    void      createCasings(const EdgeSet & edges, CasingMaker maker);   // once the weavings are set
+    void      alignCurves();
+
+    static void applyMoves(const CasingMoves & moves);
+
     void      setMap(MapPtr map) { this->map = map; }
     void      buildMap();
     void      validate();
 
+    void      indexCasings();       // once their painter paths are set
+    bool      cull(const QRectF & view, QVector<int> & visible) const;
+
     void      dump(QString str);
 
     MapPtr    map;
     QMap<VertexPtr,CNeighboursPtr>  weavings;
+
+protected:
+    bool      inParallel() const;
+    QVector<int> chunkStarts(int & chunkSize) const;
+    void      alignSerially();
+    QVector<QPolygonF> getCorners() const;
+    void      setCorners(const QVector<QPolygonF> & corners);
+    void      verifyInit(CasingMaker maker);
+    void      verifyAlignment(const QVector<QPolygonF> & before);
+
+private:
+    DrawIndex drawIndex;
 };
 
 #endif // CASING_SET_H
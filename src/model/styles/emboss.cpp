@@ -62,9 +62,15 @@ void Emboss::draw(GeoGraphics * gg)
         return;
     }
 
-    auto map = getProtoMap();    // from prototype
-    for (auto & casing : std::as_const(casings))
+    // only the casings in view, widened by the outline pen
+    QVector<int> visible;
+    qreal margin = 4.0 + Transform::scalex(gg->getTransform()) * outline_width;
+    bool  culled = casings.cull(gg->modelViewRect(margin),visible);
+    int   count  = (culled) ? visible.size() : casings.size();
+
+    for (int j=0; j < count; j++)
     {
+        const CasingPtr & casing = casings[(culled) ? visible[j] : j];
         drawTrap(gg, casing->side(SIDE_2)->mid, casing->side(SIDE_2)->inner, casing->side(SIDE_1)->inner, casing->side(SIDE_1)->mid);
         drawTrap(gg, casing->side(SIDE_1)->mid, casing->side(SIDE_1)->outer, casing->side(SIDE_2)->outer, casing->side(SIDE_2)->mid);
         
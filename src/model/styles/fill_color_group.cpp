@@ -105,6 +105,8 @@ void New3Coloring::draw(GeoGraphics *gg)
             QPen pen(Qt::red, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
             for (FacePtr & face : *fset)
             {
+                if (!filled->inView(face))
+                    continue;
                 EdgeSet & ep = *face.get();
                 gg->fillEdgePoly(ep,pen);
             }
@@ -121,6 +123,8 @@ void New3Coloring::draw(GeoGraphics *gg)
         for (int j=0; j < fset->size(); j++)
         {
             FacePtr face = fset->at(j);
+            if (!filled->inView(face))
+                continue;
             TPColor tpc  = cset.getTPColor(j);
             if (tpc.hidden)
             {
@@ -82,6 +82,8 @@ void New2Coloring::draw(GeoGraphics *gg)
             QPen pen(Qt::red, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
             for (const FacePtr & face : std::as_const(*fset))
             {
+                if (!filled->inView(face))
+                    continue;
                 EdgeSet & ep = *face.get();
                 gg->fillEdgePoly(ep,pen);
             }
@@ -93,6 +95,8 @@ void New2Coloring::draw(GeoGraphics *gg)
                 QPen pen(tpcolor.color, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
                 for (const FacePtr & face : std::as_const(*fset))
                 {
+                    if (!filled->inView(face))
+                        continue;
                     EdgeSet & ep = *face.get();
                     gg->fillEdgePoly(ep,pen);
                 }
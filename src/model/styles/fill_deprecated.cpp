@@ -59,6 +59,8 @@ void DeprecatedDirectColoring::draw(GeoGraphics *gg)
 
     for (const FacePtr & face : faces)
     {
+        if (!filled->inView(face))
+            continue;
         int index = face->iPalette;
         if (index >=0)
         {
@@ -108,6 +108,8 @@ void DirectColoring::draw(GeoGraphics *gg)
     for (auto it = faceMap.begin(); it != faceMap.end(); it++)
     {
         FacePtr face = it.value();
+        if (!filled->inView(face))
+            continue;
         int index = face->iPalette;
         if (index >=0)
         {
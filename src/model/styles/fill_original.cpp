@@ -81,6 +81,8 @@ void OriginalColoring::draw(GeoGraphics * gg)
         for (int i=0; i < whiteFaces.size(); i++)
         {
             FacePtr & face  = whiteFaces[i];
+            if (!filled->inView(face))
+                continue;
             QColor color = whiteColorSet.getTPColor(i).color;
             QPen pen(color, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
 
@@ -94,6 +96,8 @@ void OriginalColoring::draw(GeoGraphics * gg)
         for (int i=0; i < blackFaces.size(); i++)
         {
             FacePtr & face  = blackFaces[i];
+            if (!filled->inView(face))
+                continue;
             QColor color    = blackColorSet.getTPColor(i).color;
             QPen pen(color, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
 
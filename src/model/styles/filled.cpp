@@ -21,12 +21,18 @@ using std::shared_ptr;
 
 Filled::Filled(const ProtoPtr & proto, eFillType algorithm ) : Style(proto),original(this),new1(this),new2(this),new3(this),direct(this),deprecated(this)
 {
+    indexedDCEL = nullptr;
+    culling     = false;
+
     setAlgorithm(algorithm);
     initAlgorithmFrom(algorithm);   // sets initialised
 }
 
 Filled::Filled(const StylePtr & other) : Style(other),original(this),new1(this),new2(this),new3(this),direct(this),deprecated(this)
 {
+    indexedDCEL = nullptr;
+    culling     = false;
+
     FilledPtr filled = std::dynamic_pointer_cast<Filled>(other);
     if (filled)
     {
@@ -84,6 +90,9 @@ void Filled::initAlgorithmFrom(eFillType old)
 void Filled::resetStyleRepresentation()
 {
     currentColoring->resetStyleRepresentation();
+    faceIndex.clear();
+    faceSeq.clear();
+    indexedDCEL = nullptr;
     styled = false;
 }
 
@@ -95,6 +104,7 @@ void Filled::createStyleRepresentation()
         if (dcel)
         {
             currentColoring->createStyleRepresentation(dcel);
+            indexFaces(dcel);
         }
         styled = true;
     }
@@ -102,10 +112,53 @@ void Filled::createStyleRepresentation()
 
 void Filled::draw(GeoGraphics * gg)
 {
-    if (!isVisible() || !getPrototype()->getDCEL())
+    DCELPtr dcel = getPrototype()->getDCEL();
+    if (!isVisible() || !dcel)
     {
         return;
     }
 
+    // the colorings ask inView() for each face they fill
+    culling = false;
+    QVector<int> visible;
+    if (dcel.get() == indexedDCEL && dcel->getFaceSet().size() == faceIndex.size()
+        && faceIndex.cull(gg->modelViewRect(),visible))
+    {
+        culling = true;
+        facesInView.fill(false,faceIndex.size());
+        for (int i : std::as_const(visible))
+        {
+            facesInView[i] = true;
+        }
+    }
+
     currentColoring->draw(gg);
+
+    culling = false;
+}
+
+// Faces which were not indexed are always drawn
+bool Filled::inView(const FacePtr & face) const
+{
+    if (!culling)
+    {
+        return true;
+    }
+    int i = faceSeq.value(face.get(),-1);
+    return (i < 0 || facesInView[i]);
+}
+
+void Filled::indexFaces(const DCELPtr & dcel)
+{
+    faceSeq.clear();
+
+    QVector<QRectF> bounds;
+    const FaceSet & faces = dcel->getFaceSet();
+    for (const FacePtr & face : faces)
+    {
+        faceSeq.insert(face.get(),bounds.size());
+        bounds.push_back(face->getPainterPath().boundingRect());
+    }
+    faceIndex.build(bounds);
+    indexedDCEL = dcel.get();
 }
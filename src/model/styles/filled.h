@@ -2,6 +2,7 @@
 #ifndef FILLED_H
 #define FILLED_H
 
+#include <QHash>
 #include "sys/enums/efilltype.h"
 #include "model/styles/fill_color_maker.h"
 #include "model/styles/fill_original.h"
@@ -11,6 +12,11 @@
 #include "model/styles/fill_faces.h"
 #include "model/styles/fill_deprecated.h"
 #include "model/styles/style.h"
+#include "sys/geometry/draw_index.h"
+
+typedef std::shared_ptr<class Face>  FacePtr;
+
+class DCEL;
 
 ////////////////////////////////////////////////////////////////////////////
 //
@@ -37,6 +43,8 @@ public:
 
     void draw(GeoGraphics *gg) override;
 
+    bool inView(const FacePtr & face) const;     // while drawing
+
     eFillType    getAlgorithm() const        { return _algorithm; }
     void         setAlgorithm(eFillType algo);
     void         initAlgorithmFrom(eFillType old);
@@ -52,6 +60,8 @@ protected:
     void drawDCELDirectColor(GeoGraphics *gg);
     void drawDCELDirectColor2(GeoGraphics *gg);
 
+    void indexFaces(const DCELPtr & dcel);
+
 public:
     ColorMaker  *       currentColoring;
     OriginalColoring    original;
@@ -62,6 +72,14 @@ public:
     DeprecatedDirectColoring  deprecated;
 
     eFillType           _algorithm;
+
+private:
+    // the faces of the DCEL by their bounds, so that only those in view are filled
+    DrawIndex           faceIndex;
+    QHash<const Face*,int> faceSeq;
+    const DCEL *        indexedDCEL;
+    QVector<bool>       facesInView;
+    bool                culling;
 };
 
 typedef std::shared_ptr<Filled> FilledPtr;
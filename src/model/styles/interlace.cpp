@@ -4,6 +4,7 @@
 #include "model/styles/interlace.h"
 #include "sys/geometry/arcdata.h"
 #include "sys/geometry/debug_map.h"
+#include "sys/geometry/geo.h"
 #include "sys/geometry/map.h"
 #include "sys/geometry/neighbour_map.h"
 #include "sys/geometry/neighbours.h"
@@ -52,6 +53,7 @@ Interlace::Interlace(ProtoPtr proto) : Thick(proto)
     includeTipVertices    = false;
     interlace_start_under = false;
     iTrigger              = 0;  // for debug
+    shadowsFor            = 0.0;
 
     connect(Sys::flags, &DebugFlags::sig_dbgChanged, this, &Interlace::slot_dbgChanged, Qt::QueuedConnection);
     connect(Sys::flags, &DebugFlags::sig_dbgTrigger, this, &Interlace::slot_dbgTrigger);
@@ -88,6 +90,8 @@ Interlace::Interlace(StylePtr other) : Thick(other)
         iTrigger              = 0;  // for debug
     }
 
+    shadowsFor = 0.0;
+
     connect(Sys::flags, &DebugFlags::sig_dbgChanged, this, &Interlace::slot_dbgChanged, Qt::QueuedConnection);
     connect(Sys::flags, &DebugFlags::sig_dbgTrigger, this, &Interlace::slot_dbgTrigger);
 }
@@ -123,43 +127,81 @@ void Interlace::draw(GeoGraphics * gg)
     pen.setJoinStyle(join_style);
     pen.setCapStyle(cap_style);
 
-    for (CasingPtr & casing : casings)
-    {
-        if (solo&& index != casing->edgeIndex)
-            continue;
+    // when zoomed in, the casings in view are drawn one by one
+    QVector<int> visible;
+    qreal margin = 4.0 + Transform::scalex(gg->getTransform()) * outline_width;
+    bool  culled = !solo && casings.cull(gg->modelViewRect(margin),visible);
 
-        if (!casing->created())
-            continue;
+    if (solo)
+    {
+        // a single casing, from its own path
+        for (CasingPtr & casing : casings)
+        {
+            if (index != casing->edgeIndex || !casing->created())
+                continue;
 
-        casing->setPainterPath();
+            InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casing);
+            QPen pen2(icp->color, 1, Qt::SolidLine, cap_style, join_style);
+            casing->fillCasing(gg,pen2);
+        }
+    }
+    else if (culled)
+    {
+        for (int i : std::as_const(visible))
+        {
+            CasingPtr & casing = casings[i];
+            if (!casing->created())
+                continue;
 
-        InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casing);
-        QPen pen2(icp->color, 1, Qt::SolidLine, cap_style, join_style);
-        casing->fillCasing(gg,pen2);
+            InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casing);
+            QPen pen2(icp->color, 1, Qt::SolidLine, cap_style, join_style);
+            casing->fillCasing(gg,pen2);
+        }
+    }
+    else
+    {
+        for (ColorPath & cp : casingFills)
+        {
+            QPen pen2(cp.color, 1, Qt::SolidLine, cap_style, join_style);
+            gg->fillPath(cp.path,pen2);
+        }
     }
 
-    if (!Sys::flags->flagged(NO_SHADOW))
+    if (!Sys::flags->flagged(NO_SHADOW) && shadow > 0.0 && culled)
     {
-        for (CasingPtr & casing : casings)
+        for (int i : std::as_const(visible))
         {
-            if (shadow > 0.0)
-            {
-                InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casing);
-                QPen & spen = icp->getShadowPen();
-                spen.setJoinStyle(join_style);
-                spen.setCapStyle(cap_style);
-                icp->drawShadows(gg,shadow);
-            }
+            InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casings[i]);
+            QPen & spen = icp->getShadowPen();
+            spen.setJoinStyle(join_style);
+            spen.setCapStyle(cap_style);
+            icp->drawShadows(gg,shadow);
+        }
+    }
+    else if (!Sys::flags->flagged(NO_SHADOW) && shadow > 0.0)
+    {
+        if (shadow != shadowsFor)
+        {
+            buildShadowPaths();
+        }
+        for (ColorPath & cp : casingShadows)
+        {
+            QPen spen(cp.color, 1, Qt::SolidLine, cap_style, join_style);
+            gg->fillPath(cp.path,spen);
         }
     }
 
-    if (drawOutline != OUTLINE_NONE)
+    if (drawOutline != OUTLINE_NONE && culled)
     {
-        for (CasingPtr & casing : casings)
+        for (int i : std::as_const(visible))
         {
-            casing->drawOutline(gg,pen);
+            casings[i]->drawOutline(gg,pen);
         }
     }
+    else if (drawOutline != OUTLINE_NONE && !Sys::flags->flagged(NO_OUTLINE))
+    {
+        gg->strokePath(casingOutlines,pen);
+    }
 
     if (!Sys::flags->flagged(ILACE_DBG))
         return;
@@ -241,9 +283,78 @@ void Interlace::resetStyleRepresentation()
     Thick::resetStyleRepresentation();
     casings.reset();
     threads.clear();
+    casingFills.clear();
+    casingShadows.clear();
+    casingOutlines.clear();
     styled = false;
 }
 
+// The casing geometry is final once it is styled, so the paths are made
+// here rather than on each paint.  Consecutive casings of one colour are
+// filled together with the winding rule, so each casing is turned the same
+// way round, or where two overlap they would cancel out.  Only runs are
+// merged, so the casings still paint in order and the over-unders hold.
+void Interlace::buildPaths()
+{
+    casingFills.clear();
+    casingOutlines.clear();
+
+    for (CasingPtr & casing : casings)
+    {
+        if (!casing->created())
+            continue;
+
+        casing->setPainterPath();
+
+        InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casing);
+        addColorPath(casingFills,icp->color,casing->getPainterPath());
+
+        casingOutlines.addPath(casing->getOutlinePath());
+    }
+    casings.indexCasings();
+
+    buildShadowPaths();
+}
+
+void Interlace::buildShadowPaths()
+{
+    casingShadows.clear();
+    shadowsFor = shadow;
+    if (shadow <= 0.0)
+        return;
+
+    for (CasingPtr & casing : casings)
+    {
+        InterlaceCasingPtr icp = std::static_pointer_cast<InterlaceCasing>(casing);
+        addColorPath(casingShadows,icp->getShadowPen().color(),icp->getShadowPath(shadow));
+    }
+}
+
+void Interlace::addColorPath(QVector<ColorPath> & paths, const QColor & color, const QPainterPath & path)
+{
+    if (path.isEmpty())
+        return;
+
+    // a casing of another colour in between starts a new run
+    ColorPath * cp = nullptr;
+    if (!paths.isEmpty() && paths.last().color == color)
+    {
+        cp = &paths.last();
+    }
+    if (!cp)
+    {
+        paths.push_back(ColorPath());
+        cp = &paths.last();
+        cp->color = color;
+        cp->path.setFillRule(Qt::WindingFill);
+    }
+
+    if (Geo::isClockwise(path.toFillPolygon()))
+        cp->path.addPath(path.toReversed());
+    else
+        cp->path.addPath(path);
+}
+
 void Interlace::createStyleRepresentation()
 {
     qDebug() << "Interlace::createStyleRepresentation";
@@ -273,24 +384,18 @@ void Interlace::createStyleRepresentation()
         return;
     }
 
-    NeighbourMap nmap(map);
+    NeighbourMapPtr nmap = map->getNeighbourMap();
     for (auto & vertex : map->getVertices())
     {
-        NeighboursPtr np   = nmap.getNeighbours(vertex);
+        NeighboursPtr np   = nmap->getNeighbours(vertex);
         auto cneighbours   = std::make_shared<CasingNeighbours>(*np.get());
         casings.weavings[vertex] = cneighbours;
     }
 
-    int index = 0;
-    for (auto & edge  : map->getEdges())
+    casings.createCasings(map->getEdges(), [this](const EdgePtr & edge) -> CasingPtr
     {
-        auto casing = std::make_shared<InterlaceCasing>(&casings,edge,width);
-        casing->init();
-        casings.push_back(casing);
-        casing->edgeIndex = index;
-        edge->casingIndex = index;
-        index++;
-    }
+        return std::make_shared<InterlaceCasing>(&casings,edge,width);
+    });
 
     for (auto it = casings.weavings.begin(); it != casings.weavings.end(); it++)
     {
@@ -346,7 +451,7 @@ void Interlace::createStyleRepresentation()
         icp->createColors(defaultColor);
     }
 
-    // re-align curved edges
+    // re-align curved edges, once every casing has its circles
     if (!Sys::flags->flagged(NO_ALIGN_CURVES))
     {
         for (auto & casing : casings)
@@ -356,11 +461,9 @@ void Interlace::createStyleRepresentation()
             {
                 casing->innerCircle = Circle(edge->getArcCenter(),edge->getRadius()-width);
                 casing->outerCircle = Circle(edge->getArcCenter(),edge->getRadius()+width);
-
-                casing->alignCurvedEdgeSide1(casings);
-                casing->alignCurvedEdgeSide2(casings);
             }
         }
+        casings.alignCurves();
     }
 
     if (Sys::flags->flagged(DUMP_CASINGS)) casings.dump("aligned");
@@ -385,6 +488,8 @@ void Interlace::createStyleRepresentation()
     if (Sys::flags->flagged(VALIDATE)) casings.validate();
     if (Sys::flags->flagged(DUMP_CASINGS)) casings.dump("Complete");
 
+    buildPaths();
+
     styled = true;
 }
 
@@ -63,6 +63,18 @@ protected:
     void    drawDebugInterlace(bool solo, int index);
     bool    dbgBreak(InterlaceCasingPtr &casing, QString msg);
 
+    void    buildPaths();
+    void    buildShadowPaths();
+
+    class ColorPath
+    {
+    public:
+        QColor          color;
+        QPainterPath    path;
+    };
+
+    static void addColorPath(QVector<ColorPath> & paths, const QColor & color, const QPainterPath & path);
+
 private:
     // Parameters of the rendering.
     qreal  gap;
@@ -76,6 +88,12 @@ private:
     InterlaceCasingSet            casings;       // these are drawn
     Threads                       threads;
     QStack<InterlaceCasingPtr>    todo;
+
+    // Runs of casings of one colour merged, in casing order
+    QVector<ColorPath>            casingFills;
+    QVector<ColorPath>            casingShadows;
+    QPainterPath                  casingOutlines;
+    qreal                         shadowsFor;    // the shadow width of casingShadows
 };
 #endif
 
@@ -246,9 +246,12 @@ void InterlaceCasing::setPainterPath()
 // lines.  Here over or under (or both) could be curved lines.
 // But the simpliciication is that the shadow must fir into the the
 // thick line (curved or stright)
-void  InterlaceCasing::drawShadows(GeoGraphics * gg, qreal shadow) const
+QPainterPath InterlaceCasing::getShadowPath(qreal shadow) const
 {
+    QPainterPath spath;
+
     auto edge = wedge.lock();
+    if (!edge) return spath;
 
     // assumes only one side can have shadow
     InterlaceSide * is1 = nullptr;
@@ -267,7 +270,8 @@ void  InterlaceCasing::drawShadows(GeoGraphics * gg, qreal shadow) const
             shadowPts <<  s1->inner;
             shadowPts <<  s1->outer;
             shadowPts << (s1->outer + getShadowVector(s1->outer, s2->outer, shadow));
-            gg->fillPolygon(shadowPts,shadowPen);
+            spath.addPolygon(shadowPts);
+            spath.closeSubpath();
         }
         else
         {
@@ -284,7 +288,7 @@ void  InterlaceCasing::drawShadows(GeoGraphics * gg, qreal shadow) const
             e = base[2];
             e->chgangeToCurvedEdge(edge->getArcCenter(),CURVE_CONVEX);
             ep.compose();
-            gg->fillEdgePoly(ep,shadowPen);
+            spath = ep.getPainterPath();
         }
     }
     else if (is2->shadow)
@@ -296,7 +300,8 @@ void  InterlaceCasing::drawShadows(GeoGraphics * gg, qreal shadow) const
             shadowPts <<  s2->inner;
             shadowPts <<  s2->outer;
             shadowPts << (s2->outer + getShadowVector(s2->outer, s1->outer, shadow));
-            gg->fillPolygon(shadowPts,shadowPen);
+            spath.addPolygon(shadowPts);
+            spath.closeSubpath();
         }
         else
         {
@@ -313,9 +318,20 @@ void  InterlaceCasing::drawShadows(GeoGraphics * gg, qreal shadow) const
             e = base[3];
             e->chgangeToCurvedEdge(edge->getArcCenter(),CURVE_CONCAVE);
             ep.compose();
-            gg->fillEdgePoly(ep,shadowPen);
+            spath = ep.getPainterPath();
         }
     }
+    return spath;
+}
+
+void  InterlaceCasing::drawShadows(GeoGraphics * gg, qreal shadow) const
+{
+    QPainterPath spath = getShadowPath(shadow);
+    if (!spath.isEmpty())
+    {
+        QPen pen = shadowPen;
+        gg->fillPath(spath,pen);
+    }
 }
 
 QPointF InterlaceCasing::getShadowVector(QPointF from, QPointF to, qreal shadow) const
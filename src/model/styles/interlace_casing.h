@@ -30,11 +30,12 @@ public:
     InterlaceCasing(CasingSet *owner, EdgePtr edge, qreal width);
     ~InterlaceCasing();
 
-    void        init();
+    void        init() override;
     void        createColors(QColor defaultColor);
     void        setUnder(bool set);
 
     void        drawShadows(GeoGraphics *gg, qreal shadow) const;
+    QPainterPath getShadowPath(qreal shadow) const;      // empty if no shadow
 
     void        setShadowColor();
     void        setGap(qreal gap);
@@ -81,38 +81,23 @@ void Outline::createStyleRepresentation()
     }
 
     MapPtr map = getProtoMap();
-    NeighbourMap nmap(map);
+    NeighbourMapPtr nmap = map->getNeighbourMap();
 
     for (auto & vertex : map->getVertices())
     {
-        NeighboursPtr np   = nmap.getNeighbours(vertex);
+        NeighboursPtr np   = nmap->getNeighbours(vertex);
         auto cneighbours   = std::make_shared<CasingNeighbours>(*np.get());
         casings.weavings[vertex] = cneighbours;
     }
 
-    uint index = 0;
-    for (const EdgePtr & edge : map->getEdges())
+    casings.createCasings(map->getEdges(), [this](const EdgePtr & edge) -> CasingPtr
     {
-        OutlineCasingPtr casing = std::make_shared<OutlineCasing>(&casings,edge,width);
-        casing->init();
-        casings.push_back(casing);
-        casing->edgeIndex = index;
-        edge->casingIndex = index;
-        index++;
-    }
+        return std::make_shared<OutlineCasing>(&casings,edge,width);
+    });
 
-    for (CasingPtr & casing : casings)
+    if (!Sys::flags->flagged(NO_ALIGN_CURVES))
     {
-        auto edge = casing->getEdge();
-        if (edge && edge->isCurve())
-        {
-            if (!Sys::flags->flagged(NO_ALIGN_CURVES))
-            {
-                OutlineCasingPtr ocp = std::dynamic_pointer_cast<OutlineCasing>(casing);
-                ocp->alignCurvedEdgeSide1(casings);
-                ocp->alignCurvedEdgeSide2(casings);
-            }
-        }
+        casings.alignCurves();
     }
 
     if (Sys::flags->flagged(VALIDATE))
@@ -121,6 +106,12 @@ void Outline::createStyleRepresentation()
     if (Sys::flags->flagged(DUMP_CASINGS))
         casings.dump("Complete");
 
+    for (CasingPtr & casing : casings)
+    {
+        casing->setPainterPath();
+    }
+    casings.indexCasings();
+
     styled = true;
 }
 
@@ -134,8 +125,15 @@ void Outline::draw(GeoGraphics *gg)
     if (!styled)
         return;
 
-    for (int i=0; i < casings.size(); i++)
+    // only the casings in view, widened by the outline pen
+    QVector<int> visible;
+    qreal margin = 4.0 + Transform::scalex(gg->getTransform()) * outline_width;
+    bool  culled = casings.cull(gg->modelViewRect(margin),visible);
+    int   count  = (culled) ? visible.size() : casings.size();
+
+    for (int j=0; j < count; j++)
     {
+        int i = (culled) ? visible[j] : j;
         auto & casing = casings[i];
 
         EdgePtr edge = casing->getEdge();
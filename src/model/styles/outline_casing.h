@@ -20,7 +20,7 @@ public:
     OutlineCasing(CasingSet * owner, const EdgePtr&  edge, qreal width);
     ~OutlineCasing();
 
-    void    init();
+    void    init() override;
     void    set(QList<QPointF> & points);
 
     void setPainterPath() override;
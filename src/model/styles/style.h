@@ -63,6 +63,8 @@ public:
             void        paintToSVG();
             void        triggerPaintSVG(QSvgGenerator * generator) { this->generator = generator; paintSVG = true; }
 
+    virtual bool        canCacheImage() override    { return styled && !paintSVG; }
+
     virtual void        dump() const = 0;
             QString     getInfo() const;
             QString     getDescription() const;
@@ -79,7 +81,7 @@ public slots:
     void slot_mouseReleased(QPointF spt)      override;
     void slot_mouseDoublePressed(QPointF spt) override;
 
-    virtual void slot_styleMapUpdated(MapPtr map) { if (map == getProtoMap())Sys::render(RENDER_RESET_STYLES); }
+    virtual void slot_styleMapUpdated(MapPtr map) { if (map == getProtoMap())Sys::invalidate(INV_STYLE); }
 
 protected:
     ProtoPtr    prototype; // Contains the map to be rendered (the input geometry)
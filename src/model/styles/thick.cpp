@@ -1,12 +1,17 @@
 #include <QDebug>
+#include <QMap>
 #include <QPainter>
 #include <QPainterPathStroker>
+#include <QtMath>
 #include "gui/viewers/geo_graphics.h"
 #include "model/makers/mosaic_maker.h"
 #include "model/styles/colored.h"
 #include "model/styles/thick.h"
+#include "sys/geometry/arcdata.h"
+#include "sys/geometry/edge.h"
 #include "sys/geometry/map.h"
 #include "sys/geometry/neighbours.h"
+#include "sys/geometry/vertex.h"
 
 ////////////////////////////////////////////////////////////////////////////
 //
@@ -24,10 +29,15 @@ Thick::Thick(const ProtoPtr &  proto): Colored(proto)
     outline_color = Qt::black;
     join_style    = Qt::RoundJoin;
     cap_style     = Qt::RoundCap;
+    pathMap       = nullptr;
+    tilesBuilt    = false;
 }
 
 Thick::Thick(StylePtr other ) : Colored(other)
 {
+    pathMap    = nullptr;
+    tilesBuilt = false;
+
     std::shared_ptr<Thick> thick  = std::dynamic_pointer_cast<Thick>(other);
     if (thick)
     {
@@ -59,17 +69,80 @@ Thick::~Thick()
 void Thick::resetStyleRepresentation()
 {
     styled  = false;
+    pathMap = nullptr;
+    bodyPath.clear();
+    outlinePath.clear();
+    tiles.clear();
+    tileIndex.clear();
+    tilesBuilt = false;
 }
 
 void Thick::createStyleRepresentation()
 {
     if (!styled)
     {
-        prototype->getProtoMap(true);
+        const MapPtr & map = prototype->getProtoMap(true);
+        buildPaths(map);
         styled = true;
     }
 }
 
+bool Thick::pathsStale(const MapPtr & map)
+{
+    return (pathMap != map.get() || pathRevision != map->revision()
+            || pathWidth != width || pathOutline != drawOutline || pathOutlineWidth != outline_width
+            || pathJoin != join_style || pathCap != cap_style);
+}
+
+// Each edge is its own sub-path, so the caps and joins are those of the
+// edge by edge drawing, and the stroke is one winding filled outline.
+void Thick::buildPaths(const MapPtr & map)
+{
+    QPainterPath centre;
+    for (const auto & edge : std::as_const(map->getEdges()))
+    {
+        centre.moveTo(edge->v1->pt);
+        if (edge->isCurve())
+        {
+            ArcData ad(QLineF(edge->v1->pt,edge->v2->pt),edge->getArcCenter(),edge->getCurveType());
+            centre.arcTo(ad.rect(),ad.start(),ad.span());
+        }
+        else
+        {
+            centre.lineTo(edge->v2->pt);
+        }
+    }
+
+    QPainterPathStroker ps;
+    ps.setJoinStyle(join_style);
+    ps.setCapStyle(cap_style);
+
+    ps.setWidth(width * 2.0);
+    bodyPath = ps.createStroke(centre);
+
+    outlinePath.clear();
+    if (drawOutline != OUTLINE_NONE)
+    {
+        if (drawOutline == OUTLINE_SET)
+            ps.setWidth(width * 2 + outline_width);
+        else
+            ps.setWidth(width * 2 + 0.05);
+        outlinePath = ps.createStroke(centre);
+    }
+
+    tiles.clear();
+    tileIndex.clear();
+    tilesBuilt = false;
+
+    pathMap          = map.get();
+    pathRevision     = map->revision();
+    pathWidth        = width;
+    pathOutline      = drawOutline;
+    pathOutlineWidth = outline_width;
+    pathJoin         = join_style;
+    pathCap          = cap_style;
+}
+
 void Thick::draw(GeoGraphics * gg )
 {
     //qDebug() <<  "Thick::draw";
@@ -89,25 +162,71 @@ void Thick::draw(GeoGraphics * gg )
     // line color.  So the Outline style is a solution to this, although it is not
     // producing results as good as the Thick style.  (see sty-InterlaceTest.v5.xml)
 
+    // The strokes are made once, in buildPaths(), so a paint is one fill
+    // for the outline and one for the body.
+
+    const MapPtr & map = prototype->getProtoMap();
+    if (pathsStale(map))
+    {
+        buildPaths(map);
+    }
+
+    QColor color = colors.getFirstTPColor().color;
+    if (drawTiles(gg,map,color))
+    {
+        return;
+    }
+
     if  (drawOutline != OUTLINE_NONE)
     {
         // paint wider first
-        qreal pwidth;
-        if (drawOutline == OUTLINE_SET)
-            pwidth = width * 2 + outline_width;
-        else
-            pwidth = width * 2 + 0.05;
+        gg->fillModelPath(outlinePath,outline_color);
+    }
+
+    gg->fillModelPath(bodyPath,color);
+}
 
-        QPen pen(outline_color);
-        pen.setJoinStyle(join_style);
-        pen.setCapStyle(cap_style);
-        draw(gg,pen,pwidth);
+// When only part of the design is in view, only the tiles in view are
+// filled.  Tiles overlap where edges meet, so this is only done when the
+// colours are opaque, otherwise the overlaps would show.
+bool Thick::drawTiles(GeoGraphics * gg, const MapPtr & map, const QColor & color)
+{
+    if (color.alpha() != 255 || (drawOutline != OUTLINE_NONE && outline_color.alpha() != 255))
+    {
+        return false;
+    }
+
+    QRectF view = gg->modelViewRect();
+    QRectF all  = (drawOutline != OUTLINE_NONE) ? outlinePath.boundingRect() : bodyPath.boundingRect();
+    if (!view.isValid() || view.contains(all))
+    {
+        return false;
     }
 
-    QPen pen(colors.getFirstTPColor().color);
-    pen.setJoinStyle(join_style);
-    pen.setCapStyle(cap_style);
-    draw(gg,pen,width*2.0);
+    if (!tilesBuilt)
+    {
+        buildTiles(map);
+    }
+
+    QVector<int> visible;
+    if (!tileIndex.cull(view,visible))
+    {
+        return false;
+    }
+
+    if  (drawOutline != OUTLINE_NONE)
+    {
+        for (int i : std::as_const(visible))
+        {
+            gg->fillModelPath(tiles[i].outline,outline_color);
+        }
+    }
+
+    for (int i : std::as_const(visible))
+    {
+        gg->fillModelPath(tiles[i].body,color);
+    }
+    return true;
 }
 
 void Thick::draw(GeoGraphics *gg, QPen & pen, qreal width)
@@ -121,3 +240,61 @@ void Thick::draw(GeoGraphics *gg, QPen & pen, qreal width)
     }
 }
 
+// The edges are put in the tile under their mid-points, on a grid of
+// THICK_TILES a side over the map, and each tile is stroked as buildPaths()
+// strokes the whole map.
+void Thick::buildTiles(const MapPtr & map)
+{
+    tiles.clear();
+    tileIndex.clear();
+    tilesBuilt = true;
+
+    QRectF extent = bodyPath.boundingRect();
+    qreal  size   = qMax(extent.width(),extent.height()) / THICK_TILES;
+    if (size <= 0.0)
+    {
+        return;
+    }
+
+    QMap<QPair<int,int>,QPainterPath> centres;
+    for (const auto & edge : std::as_const(map->getEdges()))
+    {
+        QPointF mid = edge->getMidPoint();
+        QPair<int,int> cell(qFloor((mid.x() - extent.left()) / size), qFloor((mid.y() - extent.top()) / size));
+
+        QPainterPath & centre = centres[cell];
+        centre.moveTo(edge->v1->pt);
+        if (edge->isCurve())
+        {
+            ArcData ad(QLineF(edge->v1->pt,edge->v2->pt),edge->getArcCenter(),edge->getCurveType());
+            centre.arcTo(ad.rect(),ad.start(),ad.span());
+        }
+        else
+        {
+            centre.lineTo(edge->v2->pt);
+        }
+    }
+
+    QPainterPathStroker ps;
+    ps.setJoinStyle(join_style);
+    ps.setCapStyle(cap_style);
+
+    QVector<QRectF> bounds;
+    for (const QPainterPath & centre : std::as_const(centres))
+    {
+        PathTile tile;
+        ps.setWidth(width * 2.0);
+        tile.body = ps.createStroke(centre);
+        if (drawOutline != OUTLINE_NONE)
+        {
+            if (drawOutline == OUTLINE_SET)
+                ps.setWidth(width * 2 + outline_width);
+            else
+                ps.setWidth(width * 2 + 0.05);
+            tile.outline = ps.createStroke(centre);
+        }
+        bounds.push_back((drawOutline != OUTLINE_NONE) ? tile.outline.boundingRect() : tile.body.boundingRect());
+        tiles.push_back(tile);
+    }
+    tileIndex.build(bounds);
+}
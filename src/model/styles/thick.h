@@ -2,9 +2,14 @@
 #ifndef THICK_H
 #define THICK_H
 
+#include <QPainterPath>
 #include "model/styles/colored.h"
+#include "sys/geometry/draw_index.h"
+
+#define THICK_TILES 16      // tiles a side, for drawing part of the design
 
 typedef std::shared_ptr<class MapBase>      MapBasePtr;
+typedef std::shared_ptr<class Map>          MapPtr;
 typedef std::shared_ptr<class Edge>         EdgePtr;
 
 ////////////////////////////////////////////////////////////////////////////
@@ -53,6 +58,36 @@ protected:
     QColor           outline_color;
     Qt::PenJoinStyle join_style;
     Qt::PenCapStyle  cap_style;
+
+private:
+    bool    pathsStale(const MapPtr & map);
+    void    buildPaths(const MapPtr & map);
+    void    buildTiles(const MapPtr & map);
+    bool    drawTiles(GeoGraphics * gg, const MapPtr & map, const QColor & color);
+
+    class PathTile
+    {
+    public:
+        QPainterPath    body;
+        QPainterPath    outline;
+    };
+
+    // the edges stroked once, in model units, and filled on each paint
+    QPainterPath     bodyPath;
+    QPainterPath     outlinePath;
+    const Map *      pathMap;
+    quint64          pathRevision;
+    qreal            pathWidth;
+    eDrawOutline     pathOutline;
+    qreal            pathOutlineWidth;
+    Qt::PenJoinStyle pathJoin;
+    Qt::PenCapStyle  pathCap;
+
+    // the same strokes cut into tiles, for views of part of the design,
+    // made on the first such paint
+    QVector<PathTile> tiles;
+    DrawIndex        tileIndex;
+    bool             tilesBuilt;
 };
 #endif
 
@@ -24,7 +24,7 @@
 #include "sys/geometry/vertex.h"
 #include "model/tilings/tile.h"
 
-int Tile::refs = 0;
+std::atomic<int> Tile::refs = 0;
 
 using std::make_shared;
 
@@ -18,6 +18,7 @@
 // This helps later when deciding what Tiles can have Rosettes
 // in them.
 
+#include <atomic>
 #include <QObject>
 #include <QPolygonF>
 #include "sys/geometry/edge_poly.h"
@@ -72,7 +73,7 @@ public:
     QString     info();
     QString     summary();
 
-    static int  refs;
+    static std::atomic<int> refs;
 
 private:
     void        createRegularBase();
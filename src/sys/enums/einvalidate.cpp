@@ -0,0 +1,12 @@
+#include "sys/enums/einvalidate.h"
+
+const QString sInvalidNode[NUM_INV_NODES] =
+{
+    "Tiling",
+    "Motif",
+    "Prototype",
+    "Crop",
+    "Style",
+    "Border",
+    "Canvas"
+};
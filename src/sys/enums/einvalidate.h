@@ -0,0 +1,23 @@
+#pragma once
+#ifndef EINVALIDATE_H
+#define EINVALIDATE_H
+
+#include <QString>
+
+// Nodes of the invalidation graph, see Invalidator.
+// A change to a node invalidates the nodes which depend on it.
+enum eInvalidNode
+{
+    INV_TILING,         // tile shapes and placements
+    INV_MOTIF,          // motif maps
+    INV_PROTOTYPE,      // proto maps and DCELs
+    INV_CROP,           // mosaic crop
+    INV_STYLE,          // style representations
+    INV_BORDER,         // the mosaic border
+    INV_CANVAS,         // canvas size and background
+    NUM_INV_NODES
+};
+
+extern const QString sInvalidNode[];
+
+#endif
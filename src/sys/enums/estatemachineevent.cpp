@@ -43,5 +43,6 @@ const QString sMOSM_Events[] =
     E2STR(MOSM_RELOAD_PROTO_SINGLE),
     E2STR(MOSM_RELOAD_PROTO_MULTI),
     E2STR(MOSM_PROTO_DELETED),
-    E2STR(MOSM_PROTO_CHANGED)
+    E2STR(MOSM_PROTO_CHANGED),
+    E2STR(MOSM_PROTO_MOTIF_CHANGED)
 };
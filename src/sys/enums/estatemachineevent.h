@@ -73,7 +73,8 @@ enum eMOSM_Event
     MOSM_RELOAD_PROTO_SINGLE,
     MOSM_RELOAD_PROTO_MULTI,
     MOSM_PROTO_DELETED,
-    MOSM_PROTO_CHANGED
+    MOSM_PROTO_CHANGED,
+    MOSM_PROTO_MOTIF_CHANGED        // only the styles of this prototype
 };
 
 class MosaicEvent
@@ -6,6 +6,7 @@
 
 #include "sys/geometry/dcel.h"
 #include "sys/geometry/edge.h"
+#include "sys/geometry/map_arena.h"
 #include "sys/geometry/vertex.h"
 #include "sys/geometry/neighbours.h"
 #include "sys/qt/utilities.h"
@@ -116,17 +117,17 @@ void DCEL::cleanseEdges()
 
     EdgeSet forDeletion;
 
-    NeighbourMap nmap(this);
+    NeighbourMapPtr nmap = this->getNeighbourMap();
     // edges which have an unconnected end or ends make no sense  for building faces
     for (const EdgePtr & edge : std::as_const(edges))
     {
-        int n = nmap.getNeighbours(edge->v1)->numNeighbours();
+        int n = nmap->numNeighbours(edge->v1);
         if (n <2 )
         {
             forDeletion.push_back(edge);
             continue;
         }
-        n = nmap.getNeighbours(edge->v2)->numNeighbours();
+        n = nmap->numNeighbours(edge->v2);
         if (n <2 )
         {
             forDeletion.push_back(edge);
@@ -150,7 +151,7 @@ bool DCEL::fill_half_edge_table()
     qet.start();
     qDebug() << "DCEL::fill_half_edge_table" << info();
 
-    NeighbourMap nmap(this);
+    NeighbourMapPtr nmap = this->getNeighbourMap();
 
     EdgeSet deletions;
     for (const auto & edge : std::as_const(edges))
@@ -160,7 +161,7 @@ bool DCEL::fill_half_edge_table()
             edge->dvisited = true;
 
             EdgePtr current = edge;
-            EdgePtr next    = next_half_edge(nmap,current);
+            EdgePtr next    = next_half_edge(*nmap,current);
             while (next != edge)
             {
                 if (qet.elapsed() > (10 * 1000))
@@ -180,7 +181,7 @@ bool DCEL::fill_half_edge_table()
                     next->dvisited  = true;
                     current->next   = next;
                     current         = next;
-                    next            = next_half_edge(nmap,current);
+                    next            = next_half_edge(*nmap,current);
                 }
                 else
                 {
@@ -268,7 +269,7 @@ void DCEL::createFace(const EdgePtr & head)
 {
     double signedArea = 0.0;
 
-    FacePtr aface = make_shared<Face>();
+    FacePtr aface = makeArenaShared<Face>();
     faces.push_back(aface);
 
     EdgePtr e = head;
@@ -301,6 +302,9 @@ void DCEL::fill_face_table_inner_components()
 {
     qDebug() << "DCEL::fill_face_table_inner_components";
 
+    // the face boundaries are walked once, not once per loop
+    faceGrid.build(faces);
+
     for (const auto & hedge : std::as_const(edges))
     {
         EdgePtr edge = hedge;
@@ -327,10 +331,11 @@ void DCEL::fill_face_table_inner_components()
         // If no containing face, this is a top-level outer boundary
         if (!container)
         {
-            container = make_shared<Face>();
+            container = makeArenaShared<Face>();
             container->outer = true;   // top-level region
             container->incident_edge = head;
             faces.push_back(container);
+            faceGrid.insert(container);
         }
 
         // Assign this loop to the container face
@@ -342,12 +347,15 @@ void DCEL::fill_face_table_inner_components()
         }
         while (edge && edge != head);
     }
+
+    faceGrid.clear();
 }
 
 bool DCEL::check_if_point_is_inside(const VertexPtr & ver, const QVector<VertexPtr> & key)
 {
     const int n = key.size();
-    QPolygonF polygon1(n);
+    QPolygonF polygon1;
+    polygon1.reserve(n);
     for(int i = 0 ; i < n ; i++)
     {
         polygon1.push_back(key[i]->pt);
@@ -355,54 +363,45 @@ bool DCEL::check_if_point_is_inside(const VertexPtr & ver, const QVector<VertexP
     return isInside(polygon1, ver->pt);
 }
 
+// Returns the smallest face containing the loop.  The candidates come
+// from the face index, smallest first, so the first face which holds all
+// the loop's vertices is the answer.
 FacePtr DCEL::check_if_inside(const QVector<VertexPtr> & verts)
 {
     double self_area = area_poly(verts);
-    double best_area = std::numeric_limits<double>::max();
 
-    FacePtr best_face;
+    QPolygonF loop;
+    loop.reserve(verts.size());
+    for (const auto & v : verts)
+    {
+        loop.push_back(v->pt);
+    }
 
-    for (const auto & face : std::as_const(faces))
+    const auto candidates = faceGrid.containers(loop.boundingRect());
+    for (const FaceIndex::Entry * entry : candidates)
     {
-        EdgePtr head = face->incident_edge.lock();
-        if (!head)
+        if (entry->area <= self_area)
             continue;
 
-        // Reconstruct boundary of candidate face
-        QVector<VertexPtr> boundary;
-        EdgePtr e = head;
-        do
-        {
-            boundary.push_back(e->v1);
-            e = e->next.lock();
-        }
-        while (e && e != head);
-
         // Check if all verts lie inside this boundary
         bool all_inside = true;
-        for (const auto & v : verts)
+        for (const auto & pt : std::as_const(loop))
         {
-            if (!check_if_point_is_inside(v, boundary))
+            if (!isInside(entry->boundary, pt))
             {
                 all_inside = false;
                 break;
             }
         }
 
-        if (!all_inside)
-            continue;
-
-        double area = area_poly(boundary);
-
-        // Choose smallest containing face
-        if (area > self_area && area < best_area)
+        if (all_inside)
         {
-            best_area = area;
-            best_face = face;
+            return entry->face;
         }
     }
 
-    return best_face;
+    FacePtr none;
+    return none;
 }
 
 double DCEL::area_poly(const QVector<VertexPtr> &key)
@@ -583,11 +582,12 @@ VertexPtr DCEL::validAdjacent(const VertexPtr & vert)
 
 EdgePtr DCEL::findEdge(NeighbourMap & nmap, const VertexPtr &start , const VertexPtr&  end, bool expected)
 {
-    NeighboursPtr np = nmap.getNeighbours(start);
+    int row = nmap.row(start);
+    int num = (row == -1) ? 0 : nmap.rowSize(row);
 
-    for (WeakEdgePtr & wep : *np)
+    for (int i = 0; i < num; i++)
     {
-        EdgePtr edge = wep.lock();
+        EdgePtr edge = nmap.rowEdge(row,i);
         if (edge->v1 == start && edge->v2 == end)
         {
             return edge;
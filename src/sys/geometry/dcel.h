@@ -29,6 +29,7 @@ Derived from:  https://github.com/AnkurRyder/DCEL.git
 */
 
 #include "sys/geometry/map.h"
+#include "sys/geometry/face_index.h"
 #include "sys/geometry/faces.h"
 #include "sys/geometry/neighbours.h"
 #include "sys/geometry/neighbour_map.h"
@@ -109,6 +110,7 @@ protected:
     int     faceIndex(const FacePtr & face) { return faces.indexOf(face); }
 
     FaceSet faces;
+    FaceIndex faceGrid;     // face boundaries, while inner components are assigned
 };
 
 #endif // DCEL_H
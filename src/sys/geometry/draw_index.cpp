@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <QtMath>
+#include "sys/geometry/draw_index.h"
+
+#define DRAW_INDEX_MAX_SPAN 16     // cells per axis before an item is treated as large
+
+DrawIndex::DrawIndex()
+{
+    cellSize = 1.0;
+}
+
+void DrawIndex::build(const QVector<QRectF> & bounds)
+{
+    clear();
+
+    // cells the size of an average item
+    qreal total = 0.0;
+    for (const QRectF & b : std::as_const(bounds))
+    {
+        total   += qMax(b.width(),b.height());
+        _extent |= b;
+    }
+    if (bounds.size() && total > 0.0)
+    {
+        cellSize = total / bounds.size();
+    }
+
+    items = bounds;
+    for (int i = 0; i < items.size(); i++)
+    {
+        QRect cells = cellRange(items[i]);
+        if (cells.width() > DRAW_INDEX_MAX_SPAN || cells.height() > DRAW_INDEX_MAX_SPAN)
+        {
+            largeItems.push_back(i);
+            continue;
+        }
+        for (int x = cells.left(); x <= cells.right(); x++)
+        {
+            for (int y = cells.top(); y <= cells.bottom(); y++)
+            {
+                grid[QPoint(x,y)].push_back(i);
+            }
+        }
+    }
+}
+
+void DrawIndex::clear()
+{
+    items.clear();
+    grid.clear();
+    largeItems.clear();
+    _extent  = QRectF();
+    cellSize = 1.0;
+}
+
+// Returns false if nothing can be culled: the view is not known or it
+// shows everything.  Otherwise visible is the items meeting the view,
+// ascending, and may be empty.
+bool DrawIndex::cull(const QRectF & view, QVector<int> & visible) const
+{
+    visible.clear();
+
+    if (!view.isValid() || items.isEmpty() || view.contains(_extent))
+    {
+        return false;
+    }
+
+    if (!meets(view,_extent))
+    {
+        return true;
+    }
+
+    QVector<bool> seen(items.size(),false);
+
+    auto consider = [&](int i)
+    {
+        if (!seen[i])
+        {
+            seen[i] = true;
+            if (meets(items[i],view))
+            {
+                visible.push_back(i);
+            }
+        }
+    };
+
+    for (int i : std::as_const(largeItems))
+    {
+        consider(i);
+    }
+
+    // the grid does not reach past the extent
+    QRect cells = cellRange(view.intersected(_extent.adjusted(-cellSize,-cellSize,cellSize,cellSize)));
+    for (int x = cells.left(); x <= cells.right(); x++)
+    {
+        for (int y = cells.top(); y <= cells.bottom(); y++)
+        {
+            auto git = grid.constFind(QPoint(x,y));
+            if (git == grid.constEnd())
+            {
+                continue;
+            }
+            for (int i : std::as_const(git.value()))
+            {
+                consider(i);
+            }
+        }
+    }
+
+    std::sort(visible.begin(),visible.end());
+    return true;
+}
+
+QRect DrawIndex::cellRange(const QRectF & bounds) const
+{
+    int left   = qFloor(bounds.left()   / cellSize);
+    int top    = qFloor(bounds.top()    / cellSize);
+    int right  = qFloor(bounds.right()  / cellSize);
+    int bottom = qFloor(bounds.bottom() / cellSize);
+    return QRect(QPoint(left,top),QPoint(right,bottom));
+}
+
+// QRectF::intersects() is false for the empty bounds of straight
+// horizontal or vertical edges, so the edges are compared directly
+bool DrawIndex::meets(const QRectF & a, const QRectF & b)
+{
+    return (a.left() <= b.right() && b.left() <= a.right()
+            && a.top() <= b.bottom() && b.top() <= a.bottom());
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef DRAW_INDEX_H
+#define DRAW_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A uniform grid over the bounds of the things a style draws.
+//
+// A style indexes its casings, faces or tiles once, when its representation
+// is created, by the rectangle each one can paint in (model units).  When
+// the view only shows part of the design, cull() returns the items whose
+// bounds meet the visible rectangle, in the order they were indexed, which
+// is the order they are drawn in.  Items spanning too many cells are kept
+// in a short list that every query sees, like the large faces of FaceIndex.
+
+#include <QHash>
+#include <QPoint>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+class DrawIndex
+{
+public:
+    DrawIndex();
+
+    void        build(const QVector<QRectF> & bounds);
+    void        clear();
+
+    bool        cull(const QRectF & view, QVector<int> & visible) const;
+
+    int         size() const        { return items.size(); }
+    QRectF      extent() const      { return _extent; }
+
+protected:
+    QRect       cellRange(const QRectF & bounds) const;
+    static bool meets(const QRectF & a, const QRectF & b);
+
+private:
+    QVector<QRectF>             items;
+    QHash<QPoint,QVector<int>>  grid;           // indices into items
+    QVector<int>                largeItems;     // span too many cells to register
+
+    QRectF      _extent;
+    qreal       cellSize;
+};
+
+#endif
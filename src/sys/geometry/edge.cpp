@@ -9,6 +9,7 @@
 #include "sys/geometry/debug_map.h"
 #include "sys/geometry/geo.h"
 #include "sys/geometry//loose.h"
+#include "sys/geometry/map_arena.h"
 #include "sys/geometry/vertex.h"
 #ifdef QT_DEBUG
 #include "sys/sys/debugflags.h"
@@ -16,7 +17,7 @@
 
 using std::make_shared;
 
-int  Edge::refs          = 0;
+std::atomic<int> Edge::refs = 0;
 bool Edge::curvesAsLines = false;
 
 Edge::Edge()
@@ -71,7 +72,7 @@ Edge::Edge(const Edge & other)
 EdgePtr Edge::createTwin()
 {
     // has same edge index as original
-    EdgePtr ep        = make_shared<Edge>(*this);
+    EdgePtr ep        = makeArenaShared<Edge>(*this);
     ep->v1            = v2;
     ep->v2            = v1;
     if (_type == EDGETYPE_CURVE)
@@ -101,8 +102,8 @@ Edge::Edge(const EdgePtr &other, QTransform T)
     dvisited       = false;
     QPointF p1     = T.map(other->v1->pt);
     QPointF p2     = T.map(other->v2->pt);
-    v1 = make_shared<Vertex>(p1);
-    v2 = make_shared<Vertex>(p2);
+    v1 = makeArenaShared<Vertex>(p1);
+    v2 = makeArenaShared<Vertex>(p2);
     if (_type == EDGETYPE_CURVE)
     {
         arcData = other->getArcData();
@@ -8,6 +8,7 @@
 //
 // The edge component of the planar map abstraction.
 
+#include <atomic>
 #include <QPointF>
 #include <QLineF>
 
@@ -115,7 +116,7 @@ public:
 
     bool            dvisited;       // used by dcel
 
-    static int      refs;
+    static std::atomic<int> refs;
 
     uint            casingIndex;    // for debug
     static bool     curvesAsLines;  // for debug
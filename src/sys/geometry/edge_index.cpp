@@ -0,0 +1,246 @@
+#include <QtMath>
+#include "sys/geometry/edge_index.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/vertex.h"
+
+#define EDGE_INDEX_MAX_SPAN 32             // cells per axis before an edge is treated as large
+#define EDGE_INDEX_MAX_CELL 0x3ffffff0     // keeps a widened range's width within int
+
+EdgeIndex::EdgeIndex()
+{
+    cellSize = 1.0;
+    nextSeq  = 0;
+    depth    = 0;
+}
+
+void EdgeIndex::activate(const QVector<EdgePtr> & edges, qreal cellHint)
+{
+    if (depth++ == 0)
+    {
+        qreal size = averageSize(edges);
+        if (size <= 0.0)
+        {
+            size = cellHint;
+        }
+        if (size > 0.0)
+        {
+            cellSize = size;
+        }
+        rebuild(edges);
+    }
+}
+
+void EdgeIndex::deactivate()
+{
+    Q_ASSERT(depth > 0);
+    if (--depth == 0)
+    {
+        clear();
+    }
+}
+
+void EdgeIndex::rebuild(const QVector<EdgePtr> & edges)
+{
+    clear();
+    entries.reserve(edges.size());
+    for (const auto & e : std::as_const(edges))
+    {
+        insert(e);
+    }
+}
+
+void EdgeIndex::clear()
+{
+    grid.clear();
+    largeEdges.clear();
+    entries.clear();
+    populated = QRect();
+    nextSeq = 0;
+}
+
+void EdgeIndex::insert(const EdgePtr & e)
+{
+    if (entries.contains(e.get()))
+    {
+        return;     // the edge list is unique too
+    }
+
+    IndexedEdge ie;
+    ie.e   = e;
+    ie.seq = nextSeq++;
+
+    Entry entry;
+    entry.cells = cellRange(bounds(e));
+    entry.seq   = ie.seq;
+    entry.large = (entry.cells.width() > EDGE_INDEX_MAX_SPAN || entry.cells.height() > EDGE_INDEX_MAX_SPAN);
+
+    if (entry.large)
+    {
+        largeEdges.push_back(ie);
+    }
+    else
+    {
+        for (int x = entry.cells.left(); x <= entry.cells.right(); x++)
+        {
+            for (int y = entry.cells.top(); y <= entry.cells.bottom(); y++)
+            {
+                grid[QPoint(x,y)].push_back(ie);
+            }
+        }
+        populated = populated.united(entry.cells);
+    }
+    entries.insert(e.get(),entry);
+}
+
+void EdgeIndex::remove(const EdgePtr & e)
+{
+    auto it = entries.find(e.get());
+    if (it == entries.end())
+    {
+        return;
+    }
+
+    const Entry & entry = it.value();
+    if (entry.large)
+    {
+        for (int i = 0; i < largeEdges.size(); i++)
+        {
+            if (largeEdges[i].seq == entry.seq)
+            {
+                largeEdges.remove(i);
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (int x = entry.cells.left(); x <= entry.cells.right(); x++)
+        {
+            for (int y = entry.cells.top(); y <= entry.cells.bottom(); y++)
+            {
+                auto git = grid.find(QPoint(x,y));
+                if (git == grid.end())
+                {
+                    continue;
+                }
+                QVector<IndexedEdge> & cell = git.value();
+                for (int i = 0; i < cell.size(); i++)
+                {
+                    if (cell[i].seq == entry.seq)
+                    {
+                        cell.remove(i);
+                        break;
+                    }
+                }
+                if (cell.isEmpty())
+                {
+                    grid.erase(git);
+                }
+            }
+        }
+    }
+    entries.erase(it);
+}
+
+// Returns the edges near the bounds, in insertion order, without duplicates.
+// The search is widened by one cell on each side to cover the tolerances
+// used by the intersection tests.  Only populated cells are looked at, and a
+// range with more cells than the grid holds walks the grid instead.
+QVector<EdgePtr> EdgeIndex::candidates(const QRectF & bounds) const
+{
+    QRect range = cellRange(bounds).adjusted(-1,-1,1,1).intersected(populated);
+
+    QVector<IndexedEdge> found = largeEdges;
+    if (range.isEmpty())
+    {
+        // nothing registered near the bounds
+    }
+    else if (qint64(range.width()) * qint64(range.height()) > grid.size())
+    {
+        for (auto git = grid.constBegin(); git != grid.constEnd(); git++)
+        {
+            if (range.contains(git.key()))
+            {
+                found += git.value();
+            }
+        }
+    }
+    else
+    {
+        for (int x = range.left(); x <= range.right(); x++)
+        {
+            for (int y = range.top(); y <= range.bottom(); y++)
+            {
+                auto git = grid.constFind(QPoint(x,y));
+                if (git != grid.constEnd())
+                {
+                    found += git.value();
+                }
+            }
+        }
+    }
+
+    std::sort(found.begin(),found.end(),[](const IndexedEdge & a, const IndexedEdge & b) { return a.seq < b.seq; });
+
+    QVector<EdgePtr> edges;
+    edges.reserve(found.size());
+    quint64 last = 0;
+    for (const IndexedEdge & ie : std::as_const(found))
+    {
+        if (edges.isEmpty() || ie.seq != last)
+        {
+            edges.push_back(ie.e);
+            last = ie.seq;
+        }
+    }
+    return edges;
+}
+
+// A curve is bounded by its end points and whichever of the circle's
+// extreme points lie within the arc
+QRectF EdgeIndex::bounds(const EdgePtr & e)
+{
+    QRectF rect = QRectF(e->v1->pt,e->v2->pt).normalized();
+    if (e->isCurve())
+    {
+        QPointF c = e->getArcCenter();
+        qreal   r = e->getRadius();
+        const QPointF extremes[4] = { c + QPointF(r,0), c + QPointF(0,r), c - QPointF(r,0), c - QPointF(0,r) };
+        for (const QPointF & pt : extremes)
+        {
+            if (e->pointWithinArc(pt))
+            {
+                rect = rect.united(QRectF(pt,pt));
+            }
+        }
+    }
+    return rect;
+}
+
+qreal EdgeIndex::averageSize(const QVector<EdgePtr> & edges)
+{
+    if (edges.isEmpty())
+    {
+        return 0.0;
+    }
+
+    qreal total = 0.0;
+    for (const auto & e : std::as_const(edges))
+    {
+        QRectF b = bounds(e);
+        total += qMax(b.width(),b.height());
+    }
+    return total / edges.size();
+}
+
+// Cells are clamped well inside the int range, so far off geometry and the
+// one cell widening of a query cannot overflow
+QRect EdgeIndex::cellRange(const QRectF & bounds) const
+{
+    auto cell = [this](qreal v) -> int
+    {
+        qreal c = qBound(qreal(-EDGE_INDEX_MAX_CELL), std::floor(v / cellSize), qreal(EDGE_INDEX_MAX_CELL));
+        return int(c);
+    };
+    return QRect(QPoint(cell(bounds.left()),cell(bounds.top())),QPoint(cell(bounds.right()),cell(bounds.bottom())));
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef EDGE_INDEX_H
+#define EDGE_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A uniform grid broad phase over the edges of a map.
+//
+// Each edge is registered in every cell overlapped by its bounds.  For a
+// line the bounds are the segment, for a curve they are the arc's sweep,
+// since the intersection code only keeps points within the arc.  A query
+// returns every edge registered in the cells around a rectangle, in the
+// order the edges were inserted, so callers see the same sequence as a
+// walk of the map's edges.  A query never costs more than a pass over the
+// populated cells, however large its rectangle.
+//
+// While a merge is in progress edges are only ever added or split, and
+// a split edge is contained in its original bounds, so entries never go
+// stale.  Like the VertexIndex, it is activated for the duration of bulk
+// operations and then discarded.
+
+#include <QHash>
+#include <QPoint>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+typedef std::shared_ptr<class Edge>     EdgePtr;
+
+class EdgeIndex
+{
+public:
+    EdgeIndex();
+
+    void        activate(const QVector<EdgePtr> & edges, qreal cellHint);
+    void        deactivate();
+    bool        isActive() const    { return (depth > 0); }
+    void        rebuild(const QVector<EdgePtr> & edges);
+    void        clear();
+
+    void        insert(const EdgePtr & e);
+    void        remove(const EdgePtr & e);
+    QVector<EdgePtr> candidates(const QRectF & bounds) const;
+
+    int         size() const        { return entries.size(); }
+
+    static QRectF bounds(const EdgePtr & e);
+    static qreal  averageSize(const QVector<EdgePtr> & edges);
+
+protected:
+    class IndexedEdge
+    {
+    public:
+        EdgePtr     e;
+        quint64     seq;
+    };
+
+    class Entry
+    {
+    public:
+        QRect       cells;      // inclusive cell range
+        quint64     seq;
+        bool        large;
+    };
+
+    QRect       cellRange(const QRectF & bounds) const;
+
+private:
+    QHash<QPoint,QVector<IndexedEdge>>  grid;
+    QVector<IndexedEdge>                largeEdges;    // span too many cells to register
+    QHash<const Edge*,Entry>            entries;
+    QRect                               populated;     // the cells registered in, grows only
+
+    qreal       cellSize;
+    quint64     nextSeq;
+    int         depth;
+};
+
+#endif
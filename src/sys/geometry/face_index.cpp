@@ -0,0 +1,160 @@
+#include <QtMath>
+#include "sys/geometry/face_index.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/faces.h"
+#include "sys/geometry/vertex.h"
+
+#define FACE_INDEX_MAX_SPAN 16     // cells per axis before a face is treated as large
+
+FaceIndex::FaceIndex()
+{
+    cellSize = 1.0;
+}
+
+void FaceIndex::build(const QVector<FacePtr> & faces)
+{
+    clear();
+
+    // cells the size of an average face
+    qreal total = 0.0;
+    int   count = 0;
+    QVector<QPolygonF> polys;
+    polys.reserve(faces.size());
+    for (const auto & face : std::as_const(faces))
+    {
+        QPolygonF poly = boundary(face);
+        if (poly.size())
+        {
+            QRectF b = poly.boundingRect();
+            total += qMax(b.width(),b.height());
+            count++;
+        }
+        polys.push_back(poly);
+    }
+    if (count && total > 0.0)
+    {
+        cellSize = total / count;
+    }
+
+    entries.reserve(faces.size());
+    for (int i = 0; i < faces.size(); i++)
+    {
+        add(faces[i],polys[i]);
+    }
+}
+
+void FaceIndex::insert(const FacePtr & face)
+{
+    add(face,boundary(face));
+}
+
+void FaceIndex::add(const FacePtr & face, const QPolygonF & poly)
+{
+    if (poly.isEmpty())
+    {
+        return;
+    }
+
+    Entry entry;
+    entry.face     = face;
+    entry.boundary = poly;
+    entry.bounds   = poly.boundingRect();
+    entry.area     = area(poly);
+    entry.seq      = entries.size();
+    entries.push_back(entry);
+
+    QRect cells = cellRange(entry.bounds);
+    if (cells.width() > FACE_INDEX_MAX_SPAN || cells.height() > FACE_INDEX_MAX_SPAN)
+    {
+        largeFaces.push_back(entry.seq);
+        return;
+    }
+    for (int x = cells.left(); x <= cells.right(); x++)
+    {
+        for (int y = cells.top(); y <= cells.bottom(); y++)
+        {
+            grid[QPoint(x,y)].push_back(entry.seq);
+        }
+    }
+}
+
+void FaceIndex::clear()
+{
+    entries.clear();
+    grid.clear();
+    largeFaces.clear();
+}
+
+// Returns the faces whose bounds contain the rectangle, ordered by area
+// and then by insertion.
+QVector<const FaceIndex::Entry *> FaceIndex::containers(const QRectF & bounds) const
+{
+    // any container covers the rectangle's centre cell
+    QRectF  probe(bounds.center(),QSizeF(0,0));
+    QPoint  cell = cellRange(probe).topLeft();
+
+    QVector<int> found = largeFaces;
+    auto git = grid.constFind(cell);
+    if (git != grid.constEnd())
+    {
+        found += git.value();
+    }
+
+    QVector<const Entry *> result;
+    result.reserve(found.size());
+    for (int i : std::as_const(found))
+    {
+        const Entry & entry = entries[i];
+        // points on the boundary count as inside
+        QRectF b = entry.bounds.adjusted(-1e-7,-1e-7,1e-7,1e-7);
+        if (b.contains(bounds))
+        {
+            result.push_back(&entry);
+        }
+    }
+
+    std::sort(result.begin(),result.end(),[](const Entry * a, const Entry * b)
+              { return (a->area != b->area) ? (a->area < b->area) : (a->seq < b->seq); });
+    return result;
+}
+
+QPolygonF FaceIndex::boundary(const FacePtr & face)
+{
+    QPolygonF poly;
+    EdgePtr head = face->incident_edge.lock();
+    if (!head)
+    {
+        return poly;
+    }
+
+    EdgePtr e = head;
+    do
+    {
+        poly.push_back(e->v1->pt);
+        e = e->next.lock();
+    }
+    while (e && e != head);
+    return poly;
+}
+
+qreal FaceIndex::area(const QPolygonF & poly)
+{
+    qreal signedArea = 0.0;
+    int l = poly.size();
+    for (int i = 0; i < l; i++)
+    {
+        const QPointF & a = poly[i];
+        const QPointF & b = poly[(i + 1) % l];
+        signedArea += (a.x() * b.y() - b.x() * a.y());
+    }
+    return qAbs(signedArea / 2.0);
+}
+
+QRect FaceIndex::cellRange(const QRectF & bounds) const
+{
+    int left   = qFloor(bounds.left()   / cellSize);
+    int top    = qFloor(bounds.top()    / cellSize);
+    int right  = qFloor(bounds.right()  / cellSize);
+    int bottom = qFloor(bounds.bottom() / cellSize);
+    return QRect(QPoint(left,top),QPoint(right,bottom));
+}
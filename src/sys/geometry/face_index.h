@@ -0,0 +1,63 @@
+#pragma once
+#ifndef FACE_INDEX_H
+#define FACE_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A uniform grid over the boundaries of the faces of a DCEL.
+//
+// Each face's boundary polygon, bounds and area are computed once when it
+// is inserted.  The face is registered in every cell its bounds overlap,
+// except for faces spanning too many cells, such as the outer boundary,
+// which are kept in a short list that every query sees.  A query returns
+// the faces whose bounds contain a rectangle, smallest area first, which
+// is the order the DCEL wants its containing face in.
+
+#include <QHash>
+#include <QPoint>
+#include <QPolygonF>
+#include <QRect>
+#include <QRectF>
+#include <QVector>
+
+typedef std::shared_ptr<class Face>     FacePtr;
+
+class FaceIndex
+{
+public:
+    class Entry
+    {
+    public:
+        FacePtr     face;
+        QPolygonF   boundary;
+        QRectF      bounds;
+        qreal       area;
+        int         seq;
+    };
+
+    FaceIndex();
+
+    void        build(const QVector<FacePtr> & faces);
+    void        insert(const FacePtr & face);
+    void        clear();
+
+    QVector<const Entry *> containers(const QRectF & bounds) const;
+
+    int         size() const        { return entries.size(); }
+
+    static QPolygonF boundary(const FacePtr & face);
+    static qreal     area(const QPolygonF & poly);
+
+protected:
+    void        add(const FacePtr & face, const QPolygonF & poly);
+    QRect       cellRange(const QRectF & bounds) const;
+
+private:
+    QVector<Entry>              entries;
+    QHash<QPoint,QVector<int>>  grid;           // indices into entries
+    QVector<int>                largeFaces;     // span too many cells to register
+
+    qreal       cellSize;
+};
+
+#endif
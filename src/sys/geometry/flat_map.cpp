@@ -0,0 +1,205 @@
+#include <QDebug>
+#include <QtMath>
+#include "sys/geometry/flat_map.h"
+#include "sys/geometry/edge.h"
+#include "sys/geometry/geo.h"
+#include "sys/geometry/map.h"
+#include "sys/geometry/vertex.h"
+#include "sys/sys.h"
+
+FlatMap::FlatMap()
+{
+    cellSize = qSqrt(Sys::TOL);     // matches Geo::dist2(a,b) < Sys::TOL
+}
+
+void FlatMap::clear()
+{
+    positions.clear();
+    edgeV1.clear();
+    edgeV2.clear();
+    edgeArc.clear();
+    edgeSeam.clear();
+    arcs.clear();
+    cells.clear();
+}
+
+void FlatMap::reserve(int nverts, int nedges)
+{
+    positions.reserve(nverts);
+    cells.reserve(nverts);
+    edgeV1.reserve(nedges);
+    edgeV2.reserve(nedges);
+    edgeArc.reserve(nedges);
+    edgeSeam.reserve(nedges);
+}
+
+int FlatMap::addVertex(const QPointF & pt)
+{
+    CellKey key = cellKey(pt);
+
+    int best = -1;
+    for (qint64 x = key.first - 1; x <= key.first + 1; x++)
+    {
+        for (qint64 y = key.second - 1; y <= key.second + 1; y++)
+        {
+            auto cit = cells.constFind(CellKey(x,y));
+            if (cit == cells.constEnd())
+            {
+                continue;
+            }
+            for (int i : std::as_const(cit.value()))
+            {
+                if ((best == -1 || i < best) && Geo::dist2(pt,positions[i]) < Sys::TOL)
+                {
+                    best = i;
+                }
+            }
+        }
+    }
+    if (best != -1)
+    {
+        return best;
+    }
+
+    int index = positions.size();
+    positions.push_back(pt);
+    cells[key].push_back(index);
+    return index;
+}
+
+int FlatMap::addEdge(int v1, int v2, bool seam)
+{
+    edgeV1.push_back(v1);
+    edgeV2.push_back(v2);
+    edgeArc.push_back(-1);
+    edgeSeam.push_back(seam);
+    return edgeV1.size() - 1;
+}
+
+int FlatMap::addEdge(int v1, int v2, const QPointF & arcCenter, eCurveType ctype, bool seam)
+{
+    Arc arc;
+    arc.center = arcCenter;
+    arc.ctype  = ctype;
+    arcs.push_back(arc);
+
+    edgeV1.push_back(v1);
+    edgeV2.push_back(v2);
+    edgeArc.push_back(arcs.size() - 1);
+    edgeSeam.push_back(seam);
+    return edgeV1.size() - 1;
+}
+
+// Appends a transformed copy of other, welding its vertices to ours.
+// The seam flags are carried over, since a rigid placement keeps
+// boundary vertices on the boundary.
+void FlatMap::appendTransformed(const FlatMap & other, const QTransform & T)
+{
+    QVector<int> remap(other.positions.size());
+    for (int i = 0; i < other.positions.size(); i++)
+    {
+        remap[i] = addVertex(T.map(other.positions[i]));
+    }
+
+    for (int i = 0; i < other.edgeV1.size(); i++)
+    {
+        int v1 = remap[other.edgeV1[i]];
+        int v2 = remap[other.edgeV2[i]];
+        int a  = other.edgeArc[i];
+        if (a == -1)
+        {
+            addEdge(v1, v2, other.edgeSeam[i]);
+        }
+        else
+        {
+            const Arc & arc = other.arcs[a];
+            addEdge(v1, v2, T.map(arc.center), arc.ctype, other.edgeSeam[i]);
+        }
+    }
+}
+
+// A flat copy of a map.  Edges with an end near one of the boundaries
+// are flagged as seams.
+FlatMap FlatMap::fromMap(Map * map, const QVector<QPolygonF> & boundaries)
+{
+    const auto & vertices = map->getVertices();
+    const auto & edges    = map->getEdges();
+
+    FlatMap flat;
+    flat.reserve(vertices.size(),edges.size());
+
+    QHash<const Vertex*,int> index;
+    QVector<bool>            onBoundary;
+    index.reserve(vertices.size());
+    for (const auto & v : std::as_const(vertices))
+    {
+        bool near = false;
+        for (const auto & poly : std::as_const(boundaries))
+        {
+            if (Map::nearBoundary(v->pt,poly))
+            {
+                near = true;
+                break;
+            }
+        }
+        // the map's vertices are already distinct, so no welding here
+        int i = flat.positions.size();
+        flat.positions.push_back(v->pt);
+        flat.cells[flat.cellKey(v->pt)].push_back(i);
+        index.insert(v.get(),i);
+        onBoundary.push_back(near);
+    }
+
+    for (const auto & e : std::as_const(edges))
+    {
+        int v1 = index.value(e->v1.get(),-1);
+        int v2 = index.value(e->v2.get(),-1);
+        if (v1 == -1 || v2 == -1)
+        {
+            qWarning() << "FlatMap: edge vertex not in map";
+            continue;
+        }
+        bool seam = onBoundary[v1] || onBoundary[v2];
+        if (e->isCurve())
+            flat.addEdge(v1, v2, e->getArcCenter(), e->getCurveType(), seam);
+        else
+            flat.addEdge(v1, v2, seam);
+    }
+    return flat;
+}
+
+int FlatMap::numSeams() const
+{
+    return edgeSeam.count(true);
+}
+
+qint64 FlatMap::memoryBytes() const
+{
+    qint64 bytes = positions.capacity() * sizeof(QPointF);
+    bytes += (edgeV1.capacity() + edgeV2.capacity() + edgeArc.capacity()) * sizeof(int);
+    bytes += edgeSeam.capacity() * sizeof(bool);
+    bytes += arcs.capacity() * sizeof(Arc);
+    for (const auto & cell : std::as_const(cells))
+    {
+        bytes += cell.capacity() * sizeof(int);
+    }
+    bytes += cells.capacity() * (sizeof(CellKey) + sizeof(QVector<int>));   // the hash's own bookkeeping is not counted
+    return bytes;
+}
+
+// An estimate, not a measurement.  Each object is made with make_shared,
+// so it carries a control block (taken as 16 bytes), and the map holds a
+// shared pointer to it in its vector and hash set.  Container slack and
+// the hash set's nodes are not counted.
+qint64 FlatMap::estimateObjectBytes(int nverts, int nedges)
+{
+    const qint64 control = 16;
+    const qint64 holder  = 2 * sizeof(std::shared_ptr<void>);
+    return nverts * (sizeof(Vertex) + control + holder) + nedges * (sizeof(Edge) + control + holder);
+}
+
+FlatMap::CellKey FlatMap::cellKey(const QPointF & pt) const
+{
+    return CellKey(static_cast<qint64>(std::floor(pt.x() / cellSize)),
+                   static_cast<qint64>(std::floor(pt.y() / cellSize)));
+}
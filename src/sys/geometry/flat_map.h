@@ -0,0 +1,77 @@
+#pragma once
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A contiguous, index based map used while prototype maps are built.
+//
+// Vertex positions live in one array and edges are pairs of indices into
+// it, with the arc data of curved edges in a side table.  Replicating a
+// motif over hundreds of placements then costs a few array appends per
+// edge rather than a heap allocation and a round of reference counting
+// for every vertex, edge and copy link.
+//
+// Vertices are welded as they are added, with the same tolerance and the
+// same earliest-wins rule as Map::_getOrCreateVertex.  There is no
+// intersection testing: edges which may touch another copy are flagged as
+// seams and are left for Map::mergeFlat() to insert properly.
+
+#include <QHash>
+#include <QPair>
+#include <QPointF>
+#include <QPolygonF>
+#include <QTransform>
+#include <QVector>
+#include "sys/enums/edgetype.h"
+
+class Map;
+
+class FlatMap
+{
+public:
+    FlatMap();
+
+    void        clear();
+    void        reserve(int nverts, int nedges);
+
+    int         addVertex(const QPointF & pt);      // returns the index of the welded vertex
+    int         addEdge(int v1, int v2, bool seam);
+    int         addEdge(int v1, int v2, const QPointF & arcCenter, eCurveType ctype, bool seam);
+
+    void        appendTransformed(const FlatMap & other, const QTransform & T);
+
+    static FlatMap fromMap(Map * map, const QVector<QPolygonF> & boundaries);
+
+    int         numVertices() const         { return positions.size(); }
+    int         numEdges() const            { return edgeV1.size(); }
+    int         numSeams() const;
+    qint64      memoryBytes() const;                                // from the containers' capacities
+
+    static qint64 estimateObjectBytes(int nverts, int nedges);  // the same map as Vertex and Edge objects
+
+    class Arc
+    {
+    public:
+        QPointF     center;
+        eCurveType  ctype;
+    };
+
+    QVector<QPointF>    positions;
+    QVector<int>        edgeV1;
+    QVector<int>        edgeV2;
+    QVector<int>        edgeArc;        // index into arcs, or -1 for a line
+    QVector<bool>       edgeSeam;       // may touch another copy
+    QVector<Arc>        arcs;
+
+protected:
+    typedef QPair<qint64,qint64> CellKey;
+
+    CellKey     cellKey(const QPointF & pt) const;
+
+private:
+    QHash<CellKey,QVector<int>> cells;
+    qreal                       cellSize;
+};
+
+#endif
@@ -20,17 +20,19 @@
 #include "legacy/shapefactory.h"
 #include "model/settings/configuration.h"
 #include "sys/geometry/edge.h"
+#include "sys/geometry/flat_map.h"
 #include "sys/geometry/geo.h"
 #include "sys/geometry/intersect.h"
 #include "sys/geometry/loose.h"
 #include "sys/geometry/map.h"
+#include "sys/geometry/map_arena.h"
 #include "sys/geometry/map_cleanser.h"
 #include "sys/geometry/neighbour_map.h"
 #include "sys/geometry/vertex.h"
 
 using std::make_shared;
 
-int     Map::refs = 0;
+std::atomic<int> Map::refs = 0;
 QPointF Map::tmpCenter = QPointF();
 
 Map::Map(const QString & name)
@@ -104,6 +106,14 @@ void Map::set(const constMapPtr & other)
     clear();
     vertices = other->vertices;
     edges    = other->edges;
+    if (vindex.isActive())
+    {
+        vindex.rebuild(vertices);
+    }
+    if (eindex.isActive())
+    {
+        eindex.rebuild(edges);
+    }
 }
 
 MapPtr Map::copy() const
@@ -120,14 +130,14 @@ MapPtr Map::recreate() const
 
     for (const auto & vert : std::as_const(vertices))
     {
-        VertexPtr nv = make_shared<Vertex>(vert->pt);
+        VertexPtr nv = makeArenaShared<Vertex>(vert->pt);
         vert->copy   = nv;
         ret->vertices.push_back(nv);
     }
 
     for (const auto & edge : std::as_const(edges))
     {
-        EdgePtr ne = make_shared<Edge>(edge->v1->copy.lock(), edge->v2->copy.lock());
+        EdgePtr ne = makeArenaShared<Edge>(edge->v1->copy.lock(), edge->v2->copy.lock());
 
         if (edge->getType() == EDGETYPE_CURVE)
         {
@@ -144,6 +154,7 @@ MapPtr Map::recreate() const
 
 void Map::rebuildD()
 {
+    touchAll();
     qDebug() << "Map::rebuild";
     qDebug().noquote() << info();
 
@@ -185,7 +196,7 @@ EdgePtr Map::insertEdge(const VertexPtr & v1, const VertexPtr & v2)
     auto edge = edgeExists(v1,v2);
     if (!edge)
     {
-        edge = make_shared<Edge>(v1, v2);
+        edge = makeArenaShared<Edge>(v1, v2);
         _insertEdge(edge);
     }
     return edge;
@@ -204,7 +215,7 @@ EdgePtr Map::insertEdge(const VertexPtr & v1, const VertexPtr & v2, const QPoint
     auto edge = edgeExists(v1,v2);
     if (!edge)
     {
-        edge = make_shared<Edge>(v1, v2, arcCenter, ctype);
+        edge = makeArenaShared<Edge>(v1, v2, arcCenter, ctype);
         _insertEdge(edge);
     }
     return edge;
@@ -243,12 +254,27 @@ EdgePtr Map::insertEdge(const QPointF & p1, const QPointF & p2)
 
 void  Map:: XmlInsertDirect(VertexPtr v)
 {
-    vertices.push_back(v);
+    insertVertex(v);
 }
 
 void Map::XmlInsertDirect(EdgePtr e)
 {
+    touch(e);
     edges.push_back(e);
+    if (eindex.isActive())
+    {
+        eindex.insert(e);
+    }
+}
+
+void Map::insertVertex(VertexPtr v)
+{
+    touch(v);
+    vertices.push_back(v);
+    if (vindex.isActive())
+    {
+        vindex.insert(v);
+    }
 }
 
 // The publically-accessible version.
@@ -262,6 +288,11 @@ VertexPtr Map::insertVertex(const QPointF & pt)
 
 VertexPtr Map:: getVertex(const QPointF & pt) const
 {
+    if (vindex.isActive())
+    {
+        return vindex.find(pt);
+    }
+
     for (const auto & v : std::as_const(vertices))
     {
         if (Loose::equalsPt(v->pt,pt))
@@ -277,7 +308,7 @@ EdgePtr Map::makeCopy(const EdgePtr & e, QTransform T)
 {
     QPointF p1 = T.map(e->v1->pt);
     QPointF p2 = T.map(e->v2->pt);
-    EdgePtr ep = make_shared<Edge>(_getOrCreateVertex(p1),_getOrCreateVertex(p2));
+    EdgePtr ep = makeArenaShared<Edge>(_getOrCreateVertex(p1),_getOrCreateVertex(p2));
     if (e->isCurve())
     {
         QPointF ac = T.map(e->getArcCenter());
@@ -288,7 +319,7 @@ EdgePtr Map::makeCopy(const EdgePtr & e, QTransform T)
 
 EdgePtr Map::_insertCurvedEdge(const VertexPtr & v1, const VertexPtr & v2, const QPointF & center, eCurveType ctype)
 {
-    EdgePtr e = make_shared<Edge>(v1, v2,center, ctype);
+    EdgePtr e = makeArenaShared<Edge>(v1, v2,center, ctype);
 
     _insertEdgeSimple(e);
 
@@ -304,7 +335,12 @@ void Map::_insertEdgeSimple(const EdgePtr & edge)
     // NOTE - there is no need to do any further validation here
     // this has been tested and the UniqueQVector catches everything
 
+    touch(edge);
     edges.push_back(edge);
+    if (eindex.isActive())
+    {
+        eindex.insert(edge);
+    }
 }
 
 void Map::addShapeFactory(ShapeFPtr sf)
@@ -383,19 +419,62 @@ void Map::removeVertex(const VertexPtr & v)
         removeEdge(edge);
     }
 
-    vertices.removeOne(v);
+    removeVertexSimple(v);
 }
 
 void Map::removeVertexSimple(const VertexPtr &v)
 {
+    touch(v);
     vertices.removeOne(v);
+    if (vindex.isActive())
+    {
+        vindex.remove(v);
+    }
 }
 
 void Map::removeEdge(const EdgePtr & e)   // called by wipeout
 {
     if (!e) return;
 
+    touch(e);
     edges.removeOne(e);
+    if (eindex.isActive())
+    {
+        eindex.remove(e);
+    }
+}
+
+// Removes many edges in one pass over the edge list
+void Map::removeEdges(const EdgeSet & es)
+{
+    for (const auto & e : es)
+    {
+        touch(e);
+    }
+    edges.removeMany(es);
+    if (eindex.isActive())
+    {
+        for (const auto & e : es)
+        {
+            eindex.remove(e);
+        }
+    }
+}
+
+void Map::removeVerticesSimple(const QVector<VertexPtr> & vs)
+{
+    for (const auto & v : vs)
+    {
+        touch(v);
+    }
+    vertices.removeMany(vs);
+    if (vindex.isActive())
+    {
+        for (const auto & v : vs)
+        {
+            vindex.remove(v);
+        }
+    }
 }
 
 //////////////////////////////////////////
@@ -659,11 +738,12 @@ bool Map::_splitTwoEdgesByVertex(const VertexPtr & vert)
             }
 
             // Create the new edge instance.
-            EdgePtr nedge = make_shared<Edge>(vert, v2);
+            EdgePtr nedge = makeArenaShared<Edge>(vert, v2);
 
             // We don't need to fix up v1 -- it can still point to the same edge.
             // Fix up v2.
             // Fix up the edge object -- it now points to the intervening edge.
+            touch(e);
             e->setV2(vert);
 
             // Insert the new edge.
@@ -694,7 +774,7 @@ void Map::_joinEdges(const EdgePtr & e1, const EdgePtr & e2)
     VertexPtr v2 = e2->getOtherV(comV);
 
     // make new Edge
-    EdgePtr e = make_shared<Edge>(v2,v1);
+    EdgePtr e = makeArenaShared<Edge>(v2,v1);
     _insertEdge(e);
 
     // delete other edge and vertex
@@ -713,6 +793,7 @@ void Map::_mergeVertices(const constMapPtr & other, qreal tolerance)
 {
     const QVector<VertexPtr> & your_verts = other->vertices;          // reference
     QVector<VertexPtr> my_verts     = vertices;                 // local copy
+    touchAll();
     int my_size                     = my_verts.size();
     int your_size                   = your_verts.size();
 
@@ -800,6 +881,21 @@ void Map::_mergeVertices(const constMapPtr & other, qreal tolerance)
 // Casper -revised subtstantially to fix the modification of
 // the merged map. But still the same idea
 
+// The vertex and edge indices are built once for the outermost merge
+// and kept in step by the insertions and deletions made during it.
+void Map::_beginMerge(const Map * other)
+{
+    touchAll();
+    vindex.activate(vertices);
+    eindex.activate(edges,EdgeIndex::averageSize(other->edges));
+}
+
+void Map::_endMerge()
+{
+    eindex.deactivate();
+    vindex.deactivate();
+}
+
 void Map::mergeMap(const constMapPtr & other, qreal tolerance)
 {
     mergeMap(other.get(),tolerance);
@@ -809,6 +905,8 @@ void Map::mergeMap(const Map * other, qreal tolerance)
 {
     Q_UNUSED(tolerance);
 
+    _beginMerge(other);
+
     for (const auto & edge : std::as_const(other->edges))
     {
         VertexPtr v1 = _getOrCreateVertex(edge->v1->pt);
@@ -820,6 +918,8 @@ void Map::mergeMap(const Map * other, qreal tolerance)
             insertEdge(v1,v2);
     }
 
+    _endMerge();
+
     if (Sys::config->slowCleanseMapMerges)
     {
         // this removed duplicate edges but is very slow
@@ -833,70 +933,124 @@ QStack<Isect> Map::findIntersections(EdgePtr cutter)
 {
     QStack<Isect> isects;
 
-    //qDebug() << "edge count =" << edges.size();
-    for (auto & edge : std::as_const(edges))
+    if (eindex.isActive())
     {
-        //qDebug() << "edge" << ecount++;
-        if (cutter == edge)
-            continue;
-
-        if (cutter->isLine() && edge->isLine())
+        // broad phase: only the edges in the grid cells around the cutter
+        const EdgeSet candidates = eindex.candidates(EdgeIndex::bounds(cutter));
+        for (const auto & edge : candidates)
         {
-            QPointF op1 = cutter->v1->pt;
-            QPointF op2 = cutter->v2->pt;
-            QPointF p1  = edge->v1->pt;
-            QPointF p2  = edge->v2->pt;
-
-            QPointF ipt;
-            if (Intersect::getTrueIntersection(op1, op2, p1, p2, ipt))
-            {
-                // note - some of these intersects are at end points - so don't need splitting
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(ipt)));
-            }
+            _findIntersections(cutter,edge,isects);
         }
-        else if (cutter->isLine() && edge->isCurve())
+    }
+    else
+    {
+        //qDebug() << "edge count =" << edges.size();
+        for (auto & edge : std::as_const(edges))
+        {
+            _findIntersections(cutter,edge,isects);
+        }
+    }
+    //qDebug() << "intersects" << isects.size();
+    return isects;
+}
+
+void Map::findIntersectionPoints(const EdgePtr & cutter, QVector<IsectPoint> & points) const
+{
+    if (eindex.isActive())
+    {
+        const EdgeSet candidates = eindex.candidates(EdgeIndex::bounds(cutter));
+        for (const auto & edge : candidates)
         {
-            QPointF isect1;
-            QPointF isect2;
-            int count = Geo::findLineCircleIntersections(edge->getArcCenter(),edge->getRadius(),cutter->getLine(),isect1,isect2);
-            //qDebug() << "count" << count;
-            if (count && edge->pointWithinArc(isect1))
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(isect1)));
-
-            if (count == 2 && edge->pointWithinArc(isect2))
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(isect2)));
+            _findIntersectionPoints(cutter,edge,points);
         }
-        else if (cutter->isCurve() && edge->isLine())
+    }
+    else
+    {
+        for (const auto & edge : std::as_const(edges))
         {
-            QPointF isect1;
-            QPointF isect2;
-            int count = Geo::findLineCircleIntersections(cutter->getArcCenter(),cutter->getRadius(),edge->getLine(),isect1,isect2);
-            //qDebug() << "count" << count;
+            _findIntersectionPoints(cutter,edge,points);
+        }
+    }
+}
+
+// Creates (or finds) the vertices in the order of the points, so the
+// result matches findIntersections() called edge by edge.
+void Map::resolveIntersections(const QVector<IsectPoint> & points, QStack<Isect> & isects)
+{
+    isects.reserve(isects.size() + points.size());
+    for (const IsectPoint & ip : points)
+    {
+        isects.push(Isect(ip.edge,ip.cutter,_getOrCreateVertex(ip.pt)));
+    }
+}
 
-            if (count && cutter->pointWithinArc(isect1))
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(isect1)));
+void Map::_findIntersections(const EdgePtr & cutter, const EdgePtr & edge, QStack<Isect> & isects)
+{
+    QVector<IsectPoint> points;
+    _findIntersectionPoints(cutter,edge,points);
+    resolveIntersections(points,isects);
+}
 
-            if (count == 2 && cutter->pointWithinArc(isect2))
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(isect2)));
-        }
-        else if (cutter->isCurve() && edge->isCurve())
+// Geometry only - the map is not changed
+void Map::_findIntersectionPoints(const EdgePtr & cutter, const EdgePtr & edge, QVector<IsectPoint> & points)
+{
+    if (cutter == edge)
+        return;
+
+    if (cutter->isLine() && edge->isLine())
+    {
+        QPointF op1 = cutter->v1->pt;
+        QPointF op2 = cutter->v2->pt;
+        QPointF p1  = edge->v1->pt;
+        QPointF p2  = edge->v2->pt;
+
+        QPointF ipt;
+        if (Intersect::getTrueIntersection(op1, op2, p1, p2, ipt))
         {
-            QPointF isect1;
-            QPointF isect2;
-            Circle cutterC(cutter->getArcCenter(), cutter->getRadius());
-            Circle edgeC(edge->getArcCenter(),   edge->getRadius());
-            int count = Geo::circleCircleIntersectionPoints(cutterC, edgeC,isect1,isect2);
-            //qDebug() << "curve-curve count" << count;
-
-            if (count && cutter->pointWithinArc(isect1) && edge->pointWithinArc(isect1))
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(isect1)));
-
-            if (count == 2 && cutter->pointWithinArc(isect2) && edge->pointWithinArc(isect2))
-                isects.push(Isect(edge,cutter,_getOrCreateVertex(isect2)));
+            // note - some of these intersects are at end points - so don't need splitting
+            points.push_back(IsectPoint(edge,cutter,ipt));
         }
     }
-    //qDebug() << "intersects" << isects.size();
-    return isects;
+    else if (cutter->isLine() && edge->isCurve())
+    {
+        QPointF isect1;
+        QPointF isect2;
+        int count = Geo::findLineCircleIntersections(edge->getArcCenter(),edge->getRadius(),cutter->getLine(),isect1,isect2);
+        //qDebug() << "count" << count;
+        if (count && edge->pointWithinArc(isect1))
+            points.push_back(IsectPoint(edge,cutter,isect1));
+
+        if (count == 2 && edge->pointWithinArc(isect2))
+            points.push_back(IsectPoint(edge,cutter,isect2));
+    }
+    else if (cutter->isCurve() && edge->isLine())
+    {
+        QPointF isect1;
+        QPointF isect2;
+        int count = Geo::findLineCircleIntersections(cutter->getArcCenter(),cutter->getRadius(),edge->getLine(),isect1,isect2);
+        //qDebug() << "count" << count;
+
+        if (count && cutter->pointWithinArc(isect1))
+            points.push_back(IsectPoint(edge,cutter,isect1));
+
+        if (count == 2 && cutter->pointWithinArc(isect2))
+            points.push_back(IsectPoint(edge,cutter,isect2));
+    }
+    else if (cutter->isCurve() && edge->isCurve())
+    {
+        QPointF isect1;
+        QPointF isect2;
+        Circle cutterC(cutter->getArcCenter(), cutter->getRadius());
+        Circle edgeC(edge->getArcCenter(),   edge->getRadius());
+        int count = Geo::circleCircleIntersectionPoints(cutterC, edgeC,isect1,isect2);
+        //qDebug() << "curve-curve count" << count;
+
+        if (count && cutter->pointWithinArc(isect1) && edge->pointWithinArc(isect1))
+            points.push_back(IsectPoint(edge,cutter,isect1));
+
+        if (count == 2 && cutter->pointWithinArc(isect2) && edge->pointWithinArc(isect2))
+            points.push_back(IsectPoint(edge,cutter,isect2));
+    }
 }
 
 void Map::processIntersections(QStack<Isect> & isects)
@@ -913,12 +1067,15 @@ void Map::processIntersections(QStack<Isect> & isects)
         Q_ASSERT(edge);
         Q_ASSERT(cutter);
 
+        touch(edge);
+        touch(cutter);
+
         //Sys::debugView->getMap()->insertDebugMark(vert->pt,"is");
 
         // make change to the edge which has been cut
         if (vert != edge->v1 && vert != edge->v2)
         {
-            EdgePtr edge2 = make_shared<Edge>(edge);
+            EdgePtr edge2 = makeArenaShared<Edge>(edge);
             edge->setV2(vert);
             edge2->setV1(vert);
             _insertEdgeSimple(edge2);
@@ -926,7 +1083,7 @@ void Map::processIntersections(QStack<Isect> & isects)
 
         if (vert != cutter->v1 && vert != cutter->v2)
         {
-            EdgePtr cutter2 = make_shared<Edge>(cutter); // the other part after it is split
+            EdgePtr cutter2 = makeArenaShared<Edge>(cutter); // the other part after it is split
             cutter->setV2(vert);
             cutter2->setV1(vert);
 
@@ -970,11 +1127,15 @@ void Map::mergeMany(const constMapPtr & other, const Placements & placements)
     // this function is significantly different and SLOWER than Kaplan's
     // becuse Taprats assumed PIC (polygons in contact).  This allows
     // overlapping tiles, hence the need to do a complete merge
+    _beginMerge(other.get());
+
     for (const auto & T : std::as_const(placements))
     {
         MapPtr mp = other->getTransformed(T);
         mergeMap(mp);
     }
+
+    _endMerge();
 }
 
 // It's often the case that we want to merge a transformed copy of
@@ -984,6 +1145,8 @@ void Map::mergeMany(const constMapPtr & other, const Placements & placements)
 // Here, we transform vertices as they are put into the current map.
 void Map::mergeSimpleMany(constMapPtr & other, const Placements &transforms)
 {
+    _beginMerge(other.get());
+
     for (auto & T : std::as_const(transforms))
     {
         for (const auto & overt :  std::as_const(other->vertices))
@@ -1001,19 +1164,154 @@ void Map::mergeSimpleMany(constMapPtr & other, const Placements &transforms)
 
             if (oedge->getType() == EDGETYPE_LINE)
             {
-                nedge = make_shared<Edge>(ov1, ov2);
+                nedge = makeArenaShared<Edge>(ov1, ov2);
             }
             else if (oedge->getType() == EDGETYPE_CURVE)
             {
                 QPointF pt   = T.map(oedge->getArcCenter());
-                nedge = make_shared<Edge>(ov1, ov2,pt,oedge->getCurveType());
+                nedge = makeArenaShared<Edge>(ov1, ov2,pt,oedge->getCurveType());
             }
 
             edges.push_back(nedge);
-
+            if (eindex.isActive())
+            {
+                eindex.insert(nedge);
+            }
         }
     }
     _cleanCopy();
+
+    _endMerge();
+}
+
+// A faster mergeMany for maps whose copies are polygons in contact (PIC).
+// Each copy lies within its boundary polygon, so copies can only meet on
+// the boundaries.  Edges with no end on a boundary cannot touch another
+// copy and are inserted without intersection testing.  Edges with an end
+// on a boundary take the full insertion path, which welds and splits the
+// seams just as mergeMap does.
+void Map::mergeContactMany(const constMapPtr & other, const Placements & placements, const QVector<QPolygonF> & boundaries)
+{
+    std::unordered_set<const Vertex*> seamVertices;
+    for (const auto & overt : std::as_const(other->vertices))
+    {
+        for (const auto & poly : std::as_const(boundaries))
+        {
+            if (nearBoundary(overt->pt,poly))
+            {
+                seamVertices.insert(overt.get());
+                break;
+            }
+        }
+    }
+
+    std::unordered_set<const Edge*> seams;
+    for (const auto & oedge : std::as_const(other->edges))
+    {
+        if (seamVertices.count(oedge->v1.get()) || seamVertices.count(oedge->v2.get()))
+        {
+            seams.insert(oedge.get());
+        }
+    }
+
+    mergeSeamedMany(other,placements,seams);
+}
+
+// Merges the copies of other, where the caller knows which of its edges
+// can meet another copy.  Only those seam edges are intersection tested;
+// the rest are inserted as they are.  The vertices of every copy are
+// welded as they go in.
+void Map::mergeSeamedMany(const constMapPtr & other, const Placements & placements, const std::unordered_set<const Edge*> & seams)
+{
+    _beginMerge(other.get());
+
+    for (const auto & T : std::as_const(placements))
+    {
+        for (const auto & overt :  std::as_const(other->vertices))
+        {
+            overt->copy = _getOrCreateVertex(T.map(overt->pt));
+        }
+
+        for (const auto & oedge : std::as_const(other->edges))
+        {
+            VertexPtr v1 = oedge->v1->copy.lock();
+            VertexPtr v2 = oedge->v2->copy.lock();
+
+            if (seams.count(oedge.get()))
+            {
+                if (oedge->isCurve())
+                    insertEdge(v1, v2, T.map(oedge->getArcCenter()), oedge->getCurveType());
+                else
+                    insertEdge(v1, v2);
+            }
+            else
+            {
+                EdgePtr nedge;
+                if (oedge->isCurve())
+                    nedge = makeArenaShared<Edge>(v1, v2, T.map(oedge->getArcCenter()), oedge->getCurveType());
+                else
+                    nedge = makeArenaShared<Edge>(v1, v2);
+                _insertEdgeSimple(nedge);
+            }
+        }
+    }
+    other->_cleanCopy();
+
+    _endMerge();
+}
+
+// Adds the contents of a flat map.  Its vertices are already welded and
+// its non-seam edges cannot touch anything else, so only the seam edges
+// take the full insertion path.  The edges keep their flat order.
+void Map::mergeFlat(const FlatMap & flat)
+{
+    touchAll();
+    qreal cellHint = 0.0;
+    for (int i = 0; i < flat.edgeV1.size(); i++)
+    {
+        QRectF b = QRectF(flat.positions[flat.edgeV1[i]],flat.positions[flat.edgeV2[i]]).normalized();
+        cellHint += qMax(b.width(),b.height());
+    }
+    if (flat.edgeV1.size())
+        cellHint /= flat.edgeV1.size();
+
+    vindex.activate(vertices);
+    eindex.activate(edges,cellHint);
+
+    QVector<VertexPtr> verts;
+    verts.reserve(flat.positions.size());
+    vertices.reserve(vertices.size() + flat.positions.size());
+    for (const auto & pt : std::as_const(flat.positions))
+    {
+        verts.push_back(_getOrCreateVertex(pt));
+    }
+
+    edges.reserve(edges.size() + flat.edgeV1.size());
+    for (int i = 0; i < flat.edgeV1.size(); i++)
+    {
+        const VertexPtr & v1 = verts[flat.edgeV1[i]];
+        const VertexPtr & v2 = verts[flat.edgeV2[i]];
+        int a = flat.edgeArc[i];
+
+        if (flat.edgeSeam[i])
+        {
+            if (a != -1)
+                insertEdge(v1, v2, flat.arcs[a].center, flat.arcs[a].ctype);
+            else
+                insertEdge(v1, v2);
+        }
+        else
+        {
+            EdgePtr nedge;
+            if (a != -1)
+                nedge = makeArenaShared<Edge>(v1, v2, flat.arcs[a].center, flat.arcs[a].ctype);
+            else
+                nedge = makeArenaShared<Edge>(v1, v2);
+            _insertEdgeSimple(nedge);
+        }
+    }
+
+    _endMerge();
 }
 
 void Map::removeMap(MapPtr other)
@@ -1026,11 +1324,15 @@ void Map::removeMap(MapPtr other)
 
 void  Map::addMap(MapPtr other)
 {
+    _beginMerge(other.get());
+
     for (const auto & edge : std::as_const(other->edges))
     {
-        EdgePtr ep = make_shared<Edge>(_getOrCreateVertex(edge->v1->pt),_getOrCreateVertex(edge->v2->pt));
+        EdgePtr ep = makeArenaShared<Edge>(_getOrCreateVertex(edge->v1->pt),_getOrCreateVertex(edge->v2->pt));
         _insertEdgeSimple(ep);
     }
+
+    _endMerge();
 }
 
 //////////////////////////////////////////
@@ -1041,20 +1343,32 @@ void  Map::addMap(MapPtr other)
 
 // Get a Map Vertex given that we're asserting the vertex
 // doesn't lie on an edge in the map.
+// During merges the vertex index replaces the linear scan.
 VertexPtr Map::_getOrCreateVertex(const QPointF & pt)
 {
-    for (const auto & v : std::as_const(vertices))
+    if (vindex.isActive())
     {
-        QPointF  cur = v->pt;
-        if (Geo::dist2(pt,cur) < Sys::TOL)
-        //if (comparePoints(pt, cur) == COMP_EQUAL)
+        VertexPtr v = vindex.find(pt);
+        if (v)
         {
             return v;
         }
     }
+    else
+    {
+        for (const auto & v : std::as_const(vertices))
+        {
+            QPointF  cur = v->pt;
+            if (Geo::dist2(pt,cur) < Sys::TOL)
+            //if (comparePoints(pt, cur) == COMP_EQUAL)
+            {
+                return v;
+            }
+        }
+    }
 
-    VertexPtr vert = make_shared<Vertex>(pt);
-    vertices.push_back(vert);
+    VertexPtr vert = makeArenaShared<Vertex>(pt);
+    insertVertex(vert);
     return vert;
 }
 
@@ -1097,10 +1411,10 @@ QString Map::displayVertexEdgeCounts()
         vEdgeCounts[i] = 0;
     }
 
-    NeighbourMap nmap(this);
+    NeighbourMapPtr nmap = this->getNeighbourMap();
     for (const auto & v : std::as_const(vertices))
     {
-        NeighboursPtr n = nmap.getNeighbours(v);
+        NeighboursPtr n = nmap->getNeighbours(v);
         int count = n->numNeighbours();
         if (count <= MAP_EDGECOUNT_MAX)
         {
@@ -1169,6 +1483,49 @@ bool Map::hasIntersectingEdges() const
     return false;
 }
 
+// True when every edge of the map lies inside, or on, the polygon.
+// Curved edges are not analysed and make the answer false.
+bool Map::liesWithin(const QPolygonF & poly) const
+{
+    for (const auto & v : std::as_const(vertices))
+    {
+        if (!poly.containsPoint(v->pt,Qt::OddEvenFill) && !nearBoundary(v->pt,poly))
+        {
+            return false;
+        }
+    }
+
+    for (const auto & edge : std::as_const(edges))
+    {
+        if (edge->isCurve())
+        {
+            return false;
+        }
+
+        QPointF mid = edge->getMidPoint();
+        if (!poly.containsPoint(mid,Qt::OddEvenFill) && !nearBoundary(mid,poly))
+        {
+            return false;
+        }
+
+        // an edge which touches the boundary away from its ends crosses it
+        QLineF line = edge->getLine();
+        for (int i = 0; i < poly.size(); i++)
+        {
+            QLineF side(poly[i], poly[(i+1) % poly.size()]);
+            QPointF ipt;
+            if (Intersect::getTrueIntersection(line, side, ipt))
+            {
+                if (!Loose::Near(ipt,line.p1(),Sys::NEAR_TOL) && !Loose::Near(ipt,line.p2(),Sys::NEAR_TOL))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 EdgePtr Map::edgeExists(const EdgePtr &edge) const
 {
     return edgeExists(edge->v1,edge->v2);
@@ -1176,6 +1533,20 @@ EdgePtr Map::edgeExists(const EdgePtr &edge) const
 
 EdgePtr Map::edgeExists(const VertexPtr & v1, const VertexPtr & v2) const
 {
+    if (eindex.isActive())
+    {
+        const EdgeSet candidates = eindex.candidates(QRectF(v1->pt,v2->pt).normalized());
+        for (const auto & edge : candidates)
+        {
+            if (edge->sameAs(v1,v2))
+            {
+                return edge;
+            }
+        }
+        EdgePtr rv;
+        return rv;
+    }
+
     for (const auto & edge : std::as_const(edges))
     {
         if (edge->sameAs(v1,v2))
@@ -1202,10 +1573,10 @@ EdgePtr Map::edgeExists(const QPointF & p1, const QPointF & p2) const
 
 void Map::_dumpVertices(bool full)
 {
-    NeighbourMap nmap(this);
+    NeighbourMapPtr nmap = this->getNeighbourMap();
     for (const auto & vp : std::as_const(vertices))
     {
-        NeighboursPtr n = nmap.getNeighbours(vp);
+        NeighboursPtr n = nmap->getNeighbours(vp);
         qDebug() <<  "vertex: "  << vertexIndex(vp) << "at" << vp->pt << "num neighbours" << n->size();
         if (full)
         {
@@ -1304,6 +1675,18 @@ eCompare Map::comparePoints(const QPointF & a, const QPointF & b, qreal toleranc
 	}
 }
 
+bool Map::nearBoundary(const QPointF & pt, const QPolygonF & poly)
+{
+    for (int i = 0; i < poly.size(); i++)
+    {
+        if (Geo::distToLine(pt, poly[i], poly[(i+1) % poly.size()]) < Sys::NEAR_TOL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Isect::dump() const
 {
     qDebug().noquote() << "ISECT edge" << edge->summary() << edge->v1->pt << edge->v2->pt << "cutter" << cutter->summary() << cutter->v1->pt << cutter->v2->pt << "isect" << vertex->pt;
@@ -19,6 +19,8 @@
 // tricky later.  But it's more tractable than computing overlays of
 // DCELs.
 
+#include <atomic>
+#include <unordered_set>
 #include "legacy/shapes.h"
 #include "sys/geometry/circle.h"
 #include "sys/geometry/edge_poly.h"
@@ -54,6 +56,19 @@ public:
     VertexPtr   vertex;  // the vertex for the intersection point
 };
 
+// An intersection found without touching the map, so that detection can run
+// on several threads.  It becomes an Isect when its vertex is created.
+class IsectPoint
+{
+public:
+    IsectPoint() {}
+    IsectPoint(const EdgePtr & e, const EdgePtr & c, const QPointF & p) { edge=e; cutter = c; pt = p; }
+
+    EdgePtr     edge;
+    EdgePtr     cutter;
+    QPointF     pt;
+};
+
 class Map : public MapBase
 {
     #define MAP_EDGECOUNT_MAX 16
@@ -75,7 +90,7 @@ public:
     void        clear();            // reclaim memory
     MapPtr      getTransformed(const QTransform & T) const;
 
-    void        insertVertex(VertexPtr v) { vertices.push_back(v); }
+    void        insertVertex(VertexPtr v);
     VertexPtr   insertVertex(const QPointF & pt);
     VertexPtr   getVertex(const QPointF & pt) const;
 
@@ -92,6 +107,8 @@ public:
     void        removeVertex(const VertexPtr & v);
     void        removeVertexSimple(const VertexPtr & v);
     void        removeEdge(const EdgePtr & e);
+    void        removeEdges(const EdgeSet & es);
+    void        removeVerticesSimple(const QVector<VertexPtr> & vs);
 
     // modifications
     void        embedCrop(const QRectF & rect);
@@ -108,8 +125,13 @@ public:
     void        mergeMap(const constMapPtr & other, qreal tolerance = Sys::TOL);
     void        mergeMany(const constMapPtr & other, const Placements & placements);
     void        mergeSimpleMany(constMapPtr & other, const Placements & transforms);
+    void        mergeContactMany(const constMapPtr & other, const Placements & placements, const QVector<QPolygonF> & boundaries);
+    void        mergeSeamedMany(const constMapPtr & other, const Placements & placements, const std::unordered_set<const Edge*> & seams);
+    void        mergeFlat(const class FlatMap & flat);
 
     QStack<Isect> findIntersections(EdgePtr cutter);
+    void          findIntersectionPoints(const EdgePtr & cutter, QVector<IsectPoint> & points) const;    // read-only
+    void          resolveIntersections(const QVector<IsectPoint> & points, QStack<Isect> & isects);
     void          processIntersections(QStack<Isect> & isects);
 
     EdgePtr     makeCopy(const EdgePtr & e, QTransform T);
@@ -139,6 +161,8 @@ public:
     bool        contains (const VertexPtr & v) const { return vertices.contains(v); }
     bool        contains (const EdgePtr & e)  const  { return edges.contains(e); }
     bool        hasIntersectingEdges() const;
+    bool        liesWithin(const QPolygonF & poly) const;
+    static bool nearBoundary(const QPointF & pt, const QPolygonF & poly);
     EdgePtr     edgeExists(const EdgePtr & edge) const;
     EdgePtr     edgeExists(const VertexPtr &  v1, const VertexPtr & v2) const;
     EdgePtr     edgeExists(const QPointF &  p1, const QPointF & v2) const;
@@ -146,7 +170,7 @@ public:
     //debug
     void        private_insertEdge(const EdgePtr & e) { _insertEdgeSimple(e); }
 
-    static int  refs;
+    static std::atomic<int> refs;
 
 protected:
 
@@ -163,10 +187,14 @@ private:
     bool        _splitTwoEdgesByVertex(const VertexPtr & vert);
 
     void        _mergeVertices(const constMapPtr & other, qreal tolerance = Sys::TOL);
+    void        _beginMerge(const Map * other);
+    void        _endMerge();
     void        _joinEdges(const EdgePtr & e1, const EdgePtr & e2);
 
     // getters
     VertexPtr   _getOrCreateVertex(const QPointF &pt);
+    void        _findIntersections(const EdgePtr & cutter, const EdgePtr & edge, QStack<Isect> & isects);
+    static void _findIntersectionPoints(const EdgePtr & cutter, const EdgePtr & edge, QVector<IsectPoint> & points);
 
     // debug
     void        _dumpVertices(bool full);
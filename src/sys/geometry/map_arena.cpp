@@ -0,0 +1,196 @@
+#include <QMutexLocker>
+#include "sys/geometry/map_arena.h"
+
+std::atomic<int> MapArena::refs = 0;
+thread_local MapArena::Lane * MapArena::threadLane = nullptr;
+
+MapArenaPtr MapArena::create(size_t blockSize)
+{
+    return MapArenaPtr(new MapArena(blockSize), [](MapArena * arena) { arena->drop(); });
+}
+
+MapArena::MapArena(size_t blockSize) : holders(1)
+{
+    this->blockSize = blockSize;
+    refs++;
+}
+
+MapArena::~MapArena()
+{
+    for (Lane * lane : lanes)
+    {
+        delete lane;
+    }
+    refs--;
+}
+
+void MapArena::drop()
+{
+    if (holders.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete this;
+    }
+}
+
+// The mutex is only taken when a scope opens or closes
+MapArena::Lane * MapArena::acquireLane()
+{
+    QMutexLocker locker(&mutex);
+
+    if (!idleLanes.empty())
+    {
+        Lane * lane = idleLanes.back();
+        idleLanes.pop_back();
+        return lane;
+    }
+    Lane * lane = new Lane(this);
+    lanes.push_back(lane);
+    return lane;
+}
+
+void MapArena::releaseLane(Lane * lane)
+{
+    QMutexLocker locker(&mutex);
+    idleLanes.push_back(lane);
+}
+
+qint64 MapArena::allocations() const
+{
+    QMutexLocker locker(&mutex);
+    qint64 count = 0;
+    for (const Lane * lane : lanes)
+    {
+        count += lane->numAllocations;
+    }
+    return count;
+}
+
+qint64 MapArena::bytes() const
+{
+    QMutexLocker locker(&mutex);
+    qint64 count = 0;
+    for (const Lane * lane : lanes)
+    {
+        count += lane->numBytes;
+    }
+    return count;
+}
+
+int MapArena::blocks() const
+{
+    QMutexLocker locker(&mutex);
+    size_t count = 0;
+    for (const Lane * lane : lanes)
+    {
+        count += lane->blockList.size();
+    }
+    return (int)count;
+}
+
+QString MapArena::info() const
+{
+    return QString("allocations=%1 bytes=%2KB blocks=%3").arg(allocations()).arg(bytes() / 1024).arg(blocks());
+}
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Lane
+//
+////////////////////////////////////////////////////////////////////////////
+
+MapArena::Lane::Lane(MapArena * arena) : live(0)
+{
+    this->arena    = arena;
+    next           = nullptr;
+    remaining      = 0;
+    numAllocations = 0;
+    numBytes       = 0;
+}
+
+MapArena::Lane::~Lane()
+{
+    for (char * block : blockList)
+    {
+        ::operator delete(block);
+    }
+}
+
+void * MapArena::Lane::allocate(size_t bytes, size_t align)
+{
+    if (live.fetch_add(1, std::memory_order_relaxed) == 0)
+    {
+        arena->hold();      // dropped when the lane's last object goes
+    }
+
+    size_t pad = (align - (reinterpret_cast<uintptr_t>(next) % align)) % align;
+    if (!next || pad + bytes > remaining)
+    {
+        // an oversize request gets a block of its own
+        size_t size = qMax(arena->blockSize, bytes + align);
+        char * block = static_cast<char*>(::operator new(size));
+        blockList.push_back(block);
+        next      = block;
+        remaining = size;
+        pad       = (align - (reinterpret_cast<uintptr_t>(next) % align)) % align;
+    }
+
+    void * p   = next + pad;
+    next      += pad + bytes;
+    remaining -= pad + bytes;
+
+    numAllocations++;
+    numBytes += bytes;
+    return p;
+}
+
+void MapArena::Lane::deallocate()
+{
+    if (live.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        arena->drop();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Scope
+//
+////////////////////////////////////////////////////////////////////////////
+
+MapArena::Scope::Scope(MapArena * arena)
+{
+    previous = threadLane;
+    lane     = nullptr;
+    if (arena)
+    {
+        enter(arena);
+    }
+}
+
+MapArena::Scope::~Scope()
+{
+    leave();
+    threadLane = previous;
+}
+
+void MapArena::Scope::enter(MapArena * arena)
+{
+    leave();
+    if (arena)
+    {
+        arena->hold();
+        lane = arena->acquireLane();
+    }
+    threadLane = lane;
+}
+
+void MapArena::Scope::leave()
+{
+    if (lane)
+    {
+        MapArena * arena = lane->arena;
+        arena->releaseLane(lane);
+        lane = nullptr;
+        arena->drop();
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+#ifndef MAP_ARENA_H
+#define MAP_ARENA_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A monotonic arena for the Vertex, Edge and Face objects of a build.
+//
+// A prototype build makes hundreds of thousands of small shared objects,
+// which were each allocated, and later freed, on their own.  While an
+// arena is current on a thread, makeArenaShared() carves them out of
+// large blocks instead.  Nothing is freed piecemeal: the blocks go back in
+// one go when the arena is released and its last object has gone.
+//
+// Each Scope takes a lane of its own, so a thread allocates from its own
+// blocks without locking.  A lane counts its live objects, and holds the
+// arena while it has any, so the arena outlives every object made from it
+// however long they are kept.  Only the first object of a lane and the
+// last one to go touch the arena itself.
+//
+// Arenas are made with create(), and the owner's hold is dropped when the
+// returned pointer goes.  Scopes are per thread, so worker threads taking
+// part in a build must open their own.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <QMutex>
+#include <QString>
+
+#define MAP_ARENA_BLOCK (256 * 1024)
+
+class MapArena;
+typedef std::shared_ptr<MapArena>   MapArenaPtr;
+
+class MapArena
+{
+public:
+    static MapArenaPtr create(size_t blockSize = MAP_ARENA_BLOCK);
+
+    class Lane
+    {
+    public:
+        Lane(MapArena * arena);
+        ~Lane();
+
+        void *      allocate(size_t bytes, size_t align);   // from the thread in the lane's scope
+        void        deallocate();                           // from any thread
+
+        MapArena *          arena;
+        std::vector<char*>  blockList;
+        char *              next;
+        size_t              remaining;
+
+        qint64              numAllocations;
+        qint64              numBytes;
+        std::atomic<qint64> live;
+    };
+
+    qint64      allocations() const;
+    qint64      bytes() const;
+    int         blocks() const;
+    QString     info() const;
+
+    static Lane *     currentLane()     { return threadLane; }
+    static MapArena * current()         { return threadLane ? threadLane->arena : nullptr; }
+
+    class Scope
+    {
+    public:
+        Scope(MapArena * arena = nullptr);
+        ~Scope();
+
+        void    enter(MapArena * arena);    // nullptr for no arena
+
+    private:
+        void    leave();
+
+        Lane *  previous;
+        Lane *  lane;
+    };
+
+    static std::atomic<int> refs;
+
+protected:
+    MapArena(size_t blockSize);
+    ~MapArena();
+
+    void        hold()                  { holders.fetch_add(1, std::memory_order_relaxed); }
+    void        drop();
+
+    Lane *      acquireLane();
+    void        releaseLane(Lane * lane);
+
+private:
+    std::vector<Lane*>  lanes;
+    std::vector<Lane*>  idleLanes;
+    size_t              blockSize;
+
+    std::atomic<int>    holders;    // the owner, open scopes and lanes with live objects
+    mutable QMutex      mutex;      // guards the lane lists
+
+    static thread_local Lane * threadLane;
+};
+
+// An allocator for std::allocate_shared.  Deallocation is left to the arena.
+template <class T> class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    ArenaAllocator(MapArena::Lane * lane) : lane(lane) {}
+    template <class U> ArenaAllocator(const ArenaAllocator<U> & other) : lane(other.lane) {}
+
+    T *     allocate(size_t n)          { return static_cast<T*>(lane->allocate(n * sizeof(T), alignof(T))); }
+    void    deallocate(T *, size_t)     { lane->deallocate(); }
+
+    template <class U> bool operator==(const ArenaAllocator<U> & other) const { return lane == other.lane; }
+    template <class U> bool operator!=(const ArenaAllocator<U> & other) const { return lane != other.lane; }
+
+    MapArena::Lane * lane;
+};
+
+// make_shared, from the current arena if there is one
+template <class T, class... Args> std::shared_ptr<T> makeArenaShared(Args &&... args)
+{
+    MapArena::Lane * lane = MapArena::currentLane();
+    if (lane)
+    {
+        return std::allocate_shared<T>(ArenaAllocator<T>(lane), std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+#endif
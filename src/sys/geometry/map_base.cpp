@@ -6,6 +6,8 @@
 #include "sys/geometry/neighbours.h"
 #include "sys/geometry/neighbour_map.h"
 
+#define DIRTY_MIN_LIMIT 64      // regions larger than this, or half the map, are verified in full
+
 void MapBase::paint(QPainter * painter, QTransform & tr,bool shoWDirn, bool showArcCenters, bool showVertices, bool showEdges)
 {
     // set pen before calling this
@@ -72,6 +74,7 @@ void MapBase::paint(QPainter * painter, QTransform & tr,bool shoWDirn, bool show
 // Angles don't change.  So we can just transform each vertex.
 void MapBase::transform(const QTransform & T)
 {
+    touchAll();
     for (const auto & vert : std::as_const(vertices))
     {
         vert->setPt(T.map(vert->pt));
@@ -84,13 +87,83 @@ void MapBase::transform(const QTransform & T)
             edge->chgangeToCurvedEdge(pt,edge->getCurveType());
         }
     }
+
+    if (vindex.isActive())
+    {
+        vindex.rebuild(vertices);
+    }
+    if (eindex.isActive())
+    {
+        eindex.rebuild(edges);
+    }
+    resetNeighbourMap();    // a reflection reverses the angular order
 }
 
 void MapBase::wipeout()
 {
+    touchAll();
     // better to remove edges before removing vertices
     edges.clear();          // unnecessary from destructor but not elsewhere
     vertices.clear();       // unneccesary from destructor but not elsewhere
+    if (vindex.isActive())
+    {
+        vindex.clear();
+    }
+    if (eindex.isActive())
+    {
+        eindex.clear();
+    }
+}
+
+// The table is rebuilt when the vertex or edge lists have changed since it
+// was made.  Changes which leave the lists alone, such as moving a vertex,
+// must call resetNeighbourMap().
+NeighbourMapPtr MapBase::getNeighbourMap()
+{
+    QMutexLocker locker(&neighbourMutex);
+
+    if (!neighbourMap || neighbourRevision != revision())
+    {
+        neighbourMap      = std::make_shared<NeighbourMap>(this);
+        neighbourRevision = revision();
+    }
+    return neighbourMap;
+}
+
+void MapBase::resetNeighbourMap()
+{
+    QMutexLocker locker(&neighbourMutex);
+
+    moves = nextContentRevision();
+    neighbourMap.reset();
+}
+
+// The dirty region is kept as vertices: the verifier checks each one, its
+// edges and the far ends of those edges.  Touch a vertex after moving it,
+// and an edge before re-ending it, so that both old and new ends are
+// covered.  Once the region grows past half the map it is not worth
+// tracking, and the next verify is a full one.
+void MapBase::touch(const VertexPtr & v)
+{
+    if (dirtyAll || !v)
+    {
+        return;
+    }
+    dirtyVertices.push_back(v);
+    if (dirtyVertices.size() > qMax(DIRTY_MIN_LIMIT, (int)vertices.size() / 2))
+    {
+        touchAll();
+    }
+}
+
+void MapBase::touch(const EdgePtr & e)
+{
+    if (dirtyAll || !e)
+    {
+        return;
+    }
+    touch(e->v1);
+    touch(e->v2);
 }
 
 bool MapBase::isEmpty() const
@@ -2,10 +2,14 @@
 #ifndef MAP_BASE_H
 #define MAP_BASE_H
 
+#include <QMutex>
 #include "sys/qt/unique_qvector.h"
+#include "sys/qt/unique_hash_qvector.h"
 #include "sys/geometry/edge.h"
 #include "sys/geometry/vertex.h"
 #include "sys/geometry/neighbours.h"
+#include "sys/geometry/edge_index.h"
+#include "sys/geometry/vertex_index.h"
 
 typedef std::shared_ptr<class NeighbourMap> NeighbourMapPtr;
 typedef std::shared_ptr<class Neighbours>   NeighboursPtr;
@@ -33,10 +37,34 @@ public:
     int vertexIndex(const VertexPtr & v) const { return vertices.indexOf(v); }
     int edgeIndex(const EdgePtr & e)     const { return edges.indexOf(e); }
 
+    NeighbourMapPtr getNeighbourMap();      // cached until the map changes
+    void            resetNeighbourMap();    // call after moving vertices or re-ending edges
+
+    // the dirty region - what has changed since the map last verified
+    void            touch(const VertexPtr & v);
+    void            touch(const EdgePtr & e);   // both ends
+    void            touchAll()              { dirtyAll = true; dirtyVertices.clear(); }
+    void            clearDirty()            { dirtyAll = false; dirtyVertices.clear(); }
+    bool            isAllDirty() const      { return dirtyAll; }
+    const QVector<VertexPtr> & getDirtyVertices() const { return dirtyVertices; }
+
+    quint64         revision() const { return qMax(qMax(vertices.revision(), edges.revision()), moves); }
+
 protected:
-    UniqueQVector<VertexPtr> vertices;
-    UniqueQVector<EdgePtr>   edges;
+    UniqueHashQVector<VertexPtr> vertices;
+    UniqueHashQVector<EdgePtr>   edges;
+
+    VertexIndex                  vindex;    // active only during bulk merges
+    EdgeIndex                    eindex;    // active only during bulk merges
+
+private:
+    NeighbourMapPtr neighbourMap;
+    quint64         neighbourRevision = 0;
+    quint64         moves        = 0;   // revision of the last resetNeighbourMap()
+    QMutex          neighbourMutex;
 
+    UniqueHashQVector<VertexPtr> dirtyVertices;
+    bool            dirtyAll = true;        // a new map has never been verified
 };
 
 #endif // MAP_BASE_H
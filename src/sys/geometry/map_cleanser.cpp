@@ -1,5 +1,10 @@
 #include <QDebug>
 #include <QStack>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <QtMath>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "sys/geometry/map.h"
 #include "sys/geometry/map_cleanser.h"
@@ -10,6 +15,10 @@
 #include "sys/geometry/loose.h"
 #include "sys/geometry/geo.h"
 #include "sys/qt/timers.h"
+#include "sys/sys.h"
+#include "model/settings/configuration.h"
+
+#define CLEANSE_PARALLEL_MIN_EDGES 256     // below this the threads cost more than they save
 
 // cleanse just cleanses - it does not verify
 void MapCleanser::cleanse(uint options, qreal sensitivity)
@@ -174,10 +183,48 @@ void MapCleanser::divideIntersectingEdges()
 {
     qDebug() << "divideIntersectingEdges - start edges =" << map->edges.count();
 
+    // Detection only reads the map, so the edges are split into chunks which
+    // each fill their own buffer.  The vertices are then created serially in
+    // edge order, giving the same Isects as a serial walk of the edges.
+    const QVector<EdgePtr> cutters = map->edges;
+    const int count = cutters.size();
+
+    QVector<QVector<IsectPoint>> buffers;
+    if (Sys::config->parallelCleanse && count >= CLEANSE_PARALLEL_MIN_EDGES)
+    {
+        const int chunks    = qMin(count, QThreadPool::globalInstance()->maxThreadCount() * 4);
+        const int chunkSize = (count + chunks - 1) / chunks;
+
+        QVector<int> starts;
+        for (int start = 0; start < count; start += chunkSize)
+        {
+            starts.push_back(start);
+        }
+        buffers.resize(starts.size());
+
+        QtConcurrent::blockingMap(starts, [this, &cutters, &buffers, count, chunkSize](const int & start)
+        {
+            QVector<IsectPoint> & buffer = buffers[start / chunkSize];
+            int end = qMin(start + chunkSize, count);
+            for (int i = start; i < end; i++)
+            {
+                map->findIntersectionPoints(cutters[i],buffer);
+            }
+        });
+    }
+    else
+    {
+        buffers.resize(1);
+        for (const auto & edge : cutters)
+        {
+            map->findIntersectionPoints(edge,buffers[0]);
+        }
+    }
+
     QStack<Isect> isects;
-    for (const auto & edge : std::as_const(map->edges))
+    for (const auto & buffer : std::as_const(buffers))
     {
-        isects += map->findIntersections(edge);
+        map->resolveIntersections(buffer,isects);
     }
 
     map->processIntersections(isects);
@@ -185,59 +232,229 @@ void MapCleanser::divideIntersectingEdges()
     qDebug() << "divideIntersectingEdges - done edges =" << map->edges.count();
 }
 
+// Joins every vertex with two edges in a straight line.  The joints are
+// found in one scan, then each run of consecutive joints is replaced by a
+// single edge between the ends of the run.
 void MapCleanser::joinColinearEdges()
 {
     qDebug() << "joinColinearEdges.........";
 
+    NeighbourMapPtr nmap = map->getNeighbourMap();
 
-    bool changed = false;
-    do
+    std::unordered_set<const Vertex*> joints;
+    for (const auto & vp : std::as_const(map->vertices))
     {
-        NeighbourMap nmap(map);     // kep rebuilding nmap
-        changed = joinOneColinearEdge(nmap);
-        //verifyMap("joinColinearEdges",false,true);
-    } while (changed);
-}
+        if (isColinearJoint(*nmap,vp))
+        {
+            joints.insert(vp.get());
+        }
+    }
+    if (joints.empty())
+    {
+        return;
+    }
+
+    std::unordered_set<const Vertex*> visited;
+    EdgeSet                           deadEdges;
+    QVector<VertexPtr>                deadVertices;
+    QVector<QPair<VertexPtr,VertexPtr>> joins;
 
-bool MapCleanser::joinOneColinearEdge(NeighbourMap & nmap)
-{
     for (const auto & vp : std::as_const(map->vertices))
     {
-        NeighboursPtr n = nmap.getNeighbours(vp);
-        int count = n->numNeighbours();
-        if (count == 2)
+        if (!joints.count(vp.get()) || visited.count(vp.get()))
         {
-            QLineF a = n->getNeighbour(0)->getLine();
-            QLineF b = n->getNeighbour(1)->getLine();
-            qreal angle = Geo::angle(a,b);
-            qDebug() << angle;
-            if (Loose::zero(angle,Sys::NEAR_TOL) || Loose::equals(angle,180.0, Sys::NEAR_TOL))
+            continue;
+        }
+
+        QVector<VertexPtr> chainVertices;
+        EdgeSet            chainEdges;
+        chainVertices.push_back(vp);
+        visited.insert(vp.get());
+
+        // walk out from the joint both ways, to the first vertex which is not a joint
+        VertexPtr ends[2];
+        int row = nmap->row(vp);
+        for (int side = 0; side < 2; side++)
+        {
+            VertexPtr from = vp;
+            EdgePtr   edge = nmap->rowEdge(row,side);
+            chainEdges.push_back(edge);
+            VertexPtr v    = edge->getOtherV(from);
+            while (joints.count(v.get()) && !visited.count(v.get()))
             {
-                // need to remove one edge, extend the other, and remove vertex
-                qDebug() << "HIT";
-                combineLinearEdges(n->getNeighbour(0),n->getNeighbour(1),vp);
-                return true;
+                visited.insert(v.get());
+                chainVertices.push_back(v);
+
+                int vrow   = nmap->row(v);
+                EdgePtr a  = nmap->rowEdge(vrow,0);
+                EdgePtr b  = nmap->rowEdge(vrow,1);
+                edge       = (a == edge) ? b : a;
+                chainEdges.push_back(edge);
+                from       = v;
+                v          = edge->getOtherV(from);
             }
+            ends[side] = v;
+        }
+
+        if (chainVertices.contains(ends[0]) || chainVertices.contains(ends[1]))
+        {
+            continue;   // a closed loop of joints has no ends to join
         }
+
+        deadVertices += chainVertices;
+        deadEdges    += chainEdges;
+        joins.push_back(qMakePair(ends[0],ends[1]));
     }
-    return false;
+
+    map->removeEdges(deadEdges);
+    map->removeVerticesSimple(deadVertices);
+    for (const auto & join : std::as_const(joins))
+    {
+        map->insertEdge(join.first,join.second);
+    }
+
+    qDebug() << "joinColinearEdges - joined" << deadVertices.size() << "vertices into" << joins.size() << "edges";
 }
 
-// combine two edges which are in a straight line with common vertex
-void MapCleanser::combineLinearEdges(const EdgePtr & a, const EdgePtr & b, const VertexPtr & common)
+bool MapCleanser::isColinearJoint(const NeighbourMap & nmap, const VertexPtr & v)
 {
-    VertexPtr newV1 = a->getOtherV(common);
-    VertexPtr newV2 = b->getOtherV(common);
-    map->insertEdge(newV1,newV2);
-    map->removeEdge(a);
-    map->removeEdge(b);
-    map->removeVertexSimple(common);
+    int row = nmap.row(v);
+    if (row == -1 || nmap.rowSize(row) != 2)
+    {
+        return false;
+    }
+
+    QLineF a = nmap.rowEdge(row,0)->getLine();
+    QLineF b = nmap.rowEdge(row,1)->getLine();
+    qreal angle = Geo::angle(a,b);
+    return (Loose::zero(angle,Sys::NEAR_TOL) || Loose::equals(angle,180.0, Sys::NEAR_TOL));
 }
 
 // coalesce identical vertices to eliminate duplicates.
+// Vertices closer than the tolerance (a squared distance) are clustered
+// using a grid whose cells are the matching distance, so only the 3x3
+// cells around a vertex are compared.  Matches are transitive, as they
+// were when the pairwise scan was repeated until nothing changed, and each
+// cluster keeps its last vertex in map order, which is the one the
+// pairwise scan kept.  The edge ends are rewritten once.
 bool MapCleanser::coalesceVertices(qreal tolerance)
 {
     qDebug().noquote() << "coalesceVertices-start" <<  map->summary() << "Tolerance = " << tolerance;
+
+    const QVector<VertexPtr> & verts = map->vertices;
+    const int size = verts.size();
+    if (size < 2 || tolerance <= 0.0)
+    {
+        qDebug().noquote() << "coalesceVertices-end  " <<  map->summary();
+        return false;
+    }
+
+    const qreal cellSize = qSqrt(tolerance);
+    typedef QPair<qint64,qint64> CellKey;
+    auto cellKey = [cellSize](const QPointF & pt)
+    {
+        return CellKey(static_cast<qint64>(std::floor(pt.x() / cellSize)),
+                       static_cast<qint64>(std::floor(pt.y() / cellSize)));
+    };
+
+    // union-find, with the larger index as the root
+    QVector<int> parent(size);
+    for (int i = 0; i < size; i++)
+    {
+        parent[i] = i;
+    }
+    auto find = [&parent](int i)
+    {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    QHash<CellKey,QVector<int>> cells;
+    cells.reserve(size);
+    int matches = 0;
+    for (int i = 0; i < size; i++)
+    {
+        const QPointF & pt = verts[i]->pt;
+        CellKey key = cellKey(pt);
+        for (qint64 x = key.first - 1; x <= key.first + 1; x++)
+        {
+            for (qint64 y = key.second - 1; y <= key.second + 1; y++)
+            {
+                auto cit = cells.constFind(CellKey(x,y));
+                if (cit == cells.constEnd())
+                {
+                    continue;
+                }
+                for (int j : std::as_const(cit.value()))
+                {
+                    if (Geo::dist2(verts[j]->pt,pt) < tolerance)
+                    {
+                        int a = find(i);
+                        int b = find(j);
+                        if (a != b)
+                        {
+                            parent[qMin(a,b)] = qMax(a,b);
+                            matches++;
+                        }
+                    }
+                }
+            }
+        }
+        cells[key].push_back(i);
+    }
+
+    qDebug() << "Vertices to replace =" << matches;
+    if (matches == 0)
+    {
+        qDebug().noquote() << "coalesceVertices-end  " <<  map->summary();
+        return false;
+    }
+
+    std::unordered_map<const Vertex*,VertexPtr> replacements;
+    QVector<VertexPtr> deletions;
+    for (int i = 0; i < size; i++)
+    {
+        int root = find(i);
+        if (root != i)
+        {
+            replacements[verts[i].get()] = verts[root];
+            deletions.push_back(verts[i]);
+        }
+    }
+
+    for (const auto & edge : std::as_const(map->edges))
+    {
+        auto it = replacements.find(edge->v1.get());
+        if (it != replacements.end())
+        {
+            edge->setV1(it->second);
+            map->touch(edge);
+        }
+        it = replacements.find(edge->v2.get());
+        if (it != replacements.end())
+        {
+            edge->setV2(it->second);
+            map->touch(edge);
+        }
+    }
+
+    map->removeVerticesSimple(deletions);
+
+    cleanseVertices();
+
+    qDebug().noquote() << "coalesceVertices-end  " <<  map->summary();
+
+    return true;    // has coalesced
+}
+
+// The original pairwise version, kept to benchmark against.
+bool MapCleanser::coalesceVerticesNested(qreal tolerance)
+{
+    qDebug().noquote() << "coalesceVerticesNested-start" <<  map->summary() << "Tolerance = " << tolerance;
     qsizetype start = map->vertices.size();
 
     QMap<VertexPtr,VertexPtr> replacements;
@@ -255,7 +472,7 @@ bool MapCleanser::coalesceVertices(qreal tolerance)
     qDebug() << "Vertices to replace =" << replacements.size();
     if (replacements.size() == 0)
     {
-        qDebug().noquote() << "coalesceVertices-end  " <<  map->summary();
+        qDebug().noquote() << "coalesceVerticesNested-end  " <<  map->summary();
         return false;
     }
 
@@ -268,23 +485,25 @@ bool MapCleanser::coalesceVertices(qreal tolerance)
         {
             edge->setV1(it.value());
             deletions.push_back(it.key());
+            map->touch(edge);
         }
         it = replacements.find(edge->v2);
         if (it != replacements.end())
         {
             edge->setV2(it.value());
             deletions.push_back(it.key());
+            map->touch(edge);
         }
     }
 
     for (auto & vert : std::as_const(deletions))
     {
-        map->vertices.removeOne(vert);
+        map->removeVertexSimple(vert);
     }
 
     cleanseVertices();
 
-    qDebug().noquote() << "coalesceVertices-end  " <<  map->summary();
+    qDebug().noquote() << "coalesceVerticesNested-end  " <<  map->summary();
 
     if (map->vertices.size() != start)
     {
@@ -299,16 +518,22 @@ void MapCleanser::deDuplicateVertices(qreal tolerance)
         ;
 }
 
+void MapCleanser::deDuplicateVerticesNested(qreal tolerance)
+{
+    while (coalesceVerticesNested(tolerance))
+        ;
+}
+
 void MapCleanser::deDuplicateEdgesUsingNeighbours(bool silent)
 {
     if (!silent) qDebug().noquote() << "Map::deDuplicateEdgesUsingNeighbours BEGIN" << map->info();
 
-    NeighbourMap nmap(map);
+    NeighbourMapPtr nmap = map->getNeighbourMap();
 
     for (const auto & v :  std::as_const(map->vertices))
     {
         // examining a vertex
-        NeighboursPtr n = nmap.getNeighbours(v);
+        NeighboursPtr n = nmap->getNeighbours(v);
         deDuplicateEdges(n);
     }
     if (!silent) qDebug().noquote() << "Map::deDuplicateEdgesUsingNeighbours END"  << map->info();
@@ -348,12 +573,11 @@ void MapCleanser::deDuplicateEdges(const NeighboursPtr & vec)
 
 void MapCleanser::cleanseVertices()
 {
-    NeighbourMap nmap(map);
+    NeighbourMapPtr nmap = map->getNeighbourMap();
     std::vector<VertexPtr> baddies;
     for (const auto & v : std::as_const(map->vertices))
     {
-        NeighboursPtr n = nmap.getNeighbours(v);
-        if (n->size() == 0)
+        if (nmap->numNeighbours(v) == 0)
         {
             baddies.push_back(v);
         }
@@ -361,7 +585,7 @@ void MapCleanser::cleanseVertices()
     qDebug() << "Bad vertices to delete:" << baddies.size();
     for (const auto & v  : std::as_const(baddies))
     {
-        map->vertices.removeOne(v);
+        map->removeVertexSimple(v);
     }
 }
 
@@ -369,12 +593,11 @@ void MapCleanser::removeVerticesWithEdgeCount(uint edgeCount)
 {
     qDebug() << "removeVerticesWithEdgeCount" << edgeCount << "......";
 
-    NeighbourMap nmap(map);
+    NeighbourMapPtr nmap = map->getNeighbourMap();
     QVector<VertexPtr> verts;
     for (const auto & v : std::as_const(map->vertices))
     {
-        NeighboursPtr n = nmap.getNeighbours(v);
-        if (n->numNeighbours() == edgeCount)
+        if ((uint)nmap->numNeighbours(v) == edgeCount)
         {
             verts.push_back(v);
         }
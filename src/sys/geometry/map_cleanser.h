@@ -31,18 +31,19 @@ public:
     void cleanseVertices();
     void deDuplicateEdgesUsingNeighbours(bool silent = false);
     void deDuplicateVertices(qreal tolerance);
+    void deDuplicateVerticesNested(qreal tolerance);    // for benchmarks
 
 protected:
     void removeBadEdges();
     void divideIntersectingEdges();
     void joinColinearEdges();
     bool coalesceVertices(qreal tolerance);
-    void combineLinearEdges(const EdgePtr & a, const EdgePtr & b, const VertexPtr & common);
+    bool coalesceVerticesNested(qreal tolerance);
     void deDuplicateEdges(const NeighboursPtr & vec);
     void removeVerticesWithEdgeCount(uint edgeCount);
 
 private:
-    bool joinOneColinearEdge(NeighbourMap & nmap);
+    bool isColinearJoint(const NeighbourMap & nmap, const VertexPtr & v);
 
     Map * map;
 };
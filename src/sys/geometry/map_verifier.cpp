@@ -144,10 +144,15 @@ bool MapVerifier::verifyAndFix(bool force, bool confirm)
 //
 // It would probably be better to make this function provide the error
 // messages through a return value or exception, but whatever.
+//
+// The checks are all local to a vertex and its edges, so when the map knows
+// what has changed since it last verified, only that region and its 1-ring
+// is checked.  New maps, and maps changed wholesale, are checked in full,
+// as is everything when forceVerifyProtos is set.
 
 QVector<eMapError> MapVerifier::_verify()
 {
-    NeighbourMap * nmap = nullptr;
+    NeighbourMapPtr nmap;
 
     qtAppLog * log = qtAppLog::getInstance();
     if (!Sys::dontTrapLog)
@@ -174,20 +179,39 @@ QVector<eMapError> MapVerifier::_verify()
         goto windup;
     }
 
-    if (Sys::config->buildEmptyNmaps)
+    if (Sys::config->verifyDump)
     {
-        qInfo( ) << "Building Neighbour Map";
-        nmap = new NeighbourMap(map);
+        map->dump(true);
     }
 
-    if (Sys::config->verifyDump)
+    if (Sys::config->forceVerifyProtos || map->isAllDirty())
     {
-        map->dump(true);
+        if (Sys::config->buildEmptyNmaps)
+        {
+            qInfo( ) << "Building Neighbour Map";
+            nmap = map->getNeighbourMap();
+        }
+
+        verifyEdges();
+
+        verifyNeighbours(nmap.get());
     }
+    else
+    {
+        if (Sys::config->buildEmptyNmaps)
+        {
+            nmap = map->getNeighbourMap();
+        }
+
+        QVector<EdgePtr>   regionEdges;
+        QVector<VertexPtr> regionVertices;
+        dirtyRegion(nmap.get(),regionEdges,regionVertices);
+        qDebug() << "$$$$ Verifying region: Vertices:" << regionVertices.size() << "Edges:" << regionEdges.size();
 
-    verifyEdges();
+        verifyEdges(regionEdges);
 
-    verifyNeighbours(nmap);
+        verifyNeighbours(nmap.get(),regionVertices);
+    }
 
     qDebug() << "$$$$ Verify end";
 
@@ -206,6 +230,7 @@ windup:
     else
     {
         qInfo().noquote() << "Verify OK" << map->mname << "Vertices:" << map->vertices.size() << "Edges:" << map->edges.size();
+        map->clearDirty();
     }
 
     if (!Sys::dontTrapLog)
@@ -213,15 +238,87 @@ windup:
         log->trap(false);
     }
 
-    if (nmap)
-        delete nmap;
-
     return errors;
 }
 
+// The dirty vertices still in the map, their edges, and the far ends of
+// those edges.  A dirty vertex which has been removed is still looked up,
+// in case edges refer to it.  Without a neighbour map the edges are
+// scanned once instead.
+void MapVerifier::dirtyRegion(const NeighbourMap * nMap, QVector<EdgePtr> & regionEdges, QVector<VertexPtr> & regionVertices)
+{
+    UniqueHashQVector<VertexPtr> rverts;
+    UniqueHashQVector<EdgePtr>   redges;
+
+    UniqueHashQVector<VertexPtr> dirty(map->getDirtyVertices());
+
+    for (const auto & v : std::as_const(dirty))
+    {
+        if (map->vertices.contains(v))
+        {
+            rverts.push_back(v);
+        }
+
+        if (!nMap)
+        {
+            continue;
+        }
+        int row = nMap->row(v);
+        if (row < 0)
+        {
+            continue;
+        }
+        for (int i = 0; i < nMap->rowSize(row); i++)
+        {
+            EdgePtr edge = nMap->rowEdge(row,i);
+            if (!edge)
+            {
+                continue;
+            }
+            redges.push_back(edge);
+
+            VertexPtr other = edge->getOtherV(v);
+            if (other && map->vertices.contains(other))
+            {
+                rverts.push_back(other);
+            }
+        }
+    }
+
+    if (!nMap)
+    {
+        for (const auto & edge : std::as_const(map->edges))
+        {
+            bool d1 = dirty.contains(edge->v1);
+            bool d2 = dirty.contains(edge->v2);
+            if (!d1 && !d2)
+            {
+                continue;
+            }
+            redges.push_back(edge);
+            if (!d1 && map->vertices.contains(edge->v1))
+            {
+                rverts.push_back(edge->v1);
+            }
+            if (!d2 && map->vertices.contains(edge->v2))
+            {
+                rverts.push_back(edge->v2);
+            }
+        }
+    }
+
+    regionEdges    = redges;
+    regionVertices = rverts;
+}
+
 void MapVerifier::verifyEdges()
 {
-    for (const auto & edge : std::as_const(map->edges))
+    verifyEdges(map->edges);
+}
+
+void MapVerifier::verifyEdges(const QVector<EdgePtr> & edges)
+{
+    for (const auto & edge : std::as_const(edges))
     {
         VertexPtr v1 = edge->v1;
         VertexPtr v2 = edge->v2;
@@ -265,11 +362,11 @@ void MapVerifier::verifyEdges()
             errors.push_back(EDGE_VERTEX_UNKNOWN);
         }
 
-        NeighbourMap nmap(map);
+        NeighbourMapPtr nmap = map->getNeighbourMap();
 
         // make sure the edge is the only connection between the two endpoints
         //qDebug() << "   V1";
-        auto neighbours = nmap.getNeighbours(v1);
+        auto neighbours = nmap->getNeighbours(v1);
         for (auto & wedge : std::as_const(*neighbours))
         {
             EdgePtr eother = wedge.lock();
@@ -295,7 +392,7 @@ void MapVerifier::verifyEdges()
         }
 
         //qDebug() << "   V2";
-        neighbours = nmap.getNeighbours(v2);
+        neighbours = nmap->getNeighbours(v2);
         for (auto & wedge : std::as_const(*neighbours))
         {
             EdgePtr eother = wedge.lock();
@@ -323,6 +420,11 @@ void MapVerifier::verifyEdges()
 }
 
 void MapVerifier::verifyNeighbours(NeighbourMap * nMap)
+{
+    verifyNeighbours(nMap,map->vertices);
+}
+
+void MapVerifier::verifyNeighbours(NeighbourMap * nMap, const QVector<VertexPtr> & vertices)
 {
     if (!nMap)
     {
@@ -330,7 +432,7 @@ void MapVerifier::verifyNeighbours(NeighbourMap * nMap)
     }
 
     // Make sure the vertices each have a neighbour and all neighbours are good
-    for (const auto & vertex : std::as_const(map->vertices))
+    for (const auto & vertex : std::as_const(vertices))
     {
         NeighboursPtr neighbour = nMap->getNeighbours(vertex);
         if (!neighbour->verify())
@@ -35,13 +35,16 @@ public:
     bool        verifyAndFix(bool force = false, bool confirm = false);
 
     void        verifyEdges();
+    void        verifyEdges(const QVector<EdgePtr> & edges);
     void        verifyNeighbours(NeighbourMap *nMap);
+    void        verifyNeighbours(NeighbourMap *nMap, const QVector<VertexPtr> & vertices);
     bool        procErrors(const QVector<eMapError> &errors);
 
 protected:
 
 private:
     QVector<eMapError> _verify();
+    void        dirtyRegion(const NeighbourMap * nMap, QVector<EdgePtr> & regionEdges, QVector<VertexPtr> & regionVertices);
     void        dumpErrors(const QVector<eMapError> &theErrors);
 
     Map * map;
@@ -1,74 +1,143 @@
+#include <QDebug>
 #include "sys/geometry/edge.h"
 #include "sys/geometry/map_base.h"
 #include "sys/geometry/neighbour_map.h"
-#include "sys/geometry/edge.h"
-#include "sys/geometry/map_base.h"
 #include "sys/geometry/neighbours.h"
 #include "sys/geometry/vertex.h"
 
 NeighbourMap::NeighbourMap(MapPtr map)
 {
     this->map = map.get();
-
-    for (const auto & edge : std::as_const(map->getEdges()))
-    {
-        NeighboursPtr n = getRawNeighbours(edge->v1);
-        n->insertNeighbour(edge);
-        NeighboursPtr n2 = getRawNeighbours(edge->v2);
-        n2->insertNeighbour(edge);
-    }
+    build();
 }
 
 NeighbourMap::NeighbourMap(MapBase *map)
 {
     this->map = map;
+    build();
+}
 
-    for (const auto & edge : std::as_const(map->getEdges()))
+void NeighbourMap::build()
+{
+    const QVector<VertexPtr> & vertices = map->getVertices();
+    const EdgeSet            & edges    = map->getEdges();
+
+    QVector<Vertex*> rowVertex;
+    rows.reserve(vertices.size());
+    rowVertex.reserve(vertices.size());
+    for (const auto & v : std::as_const(vertices))
     {
-        NeighboursPtr n = getRawNeighbours(edge->v1);
-        n->insertNeighbour(edge);
-        NeighboursPtr n2 = getRawNeighbours(edge->v2);
-        n2->insertNeighbour(edge);
+        rows.insert(v.get(),rowVertex.size());
+        rowVertex.push_back(v.get());
+    }
+
+    // edges can end on vertices the map does not list, which get rows too
+    auto rowOf = [this,&rowVertex](const VertexPtr & v)
+    {
+        auto it = rows.constFind(v.get());
+        if (it != rows.constEnd())
+            return it.value();
+        int r = rowVertex.size();
+        rows.insert(v.get(),r);
+        rowVertex.push_back(v.get());
+        return r;
+    };
+
+    QVector<int> edgeRow1(edges.size());
+    QVector<int> edgeRow2(edges.size());
+    for (int i = 0; i < edges.size(); i++)
+    {
+        const EdgePtr & e = edges[i];
+        edgeRow1[i] = rowOf(e->v1);
+        edgeRow2[i] = (e->v2 == e->v1) ? -1 : rowOf(e->v2);
+    }
+
+    // count, then fill, the rows
+    offsets.fill(0,rowVertex.size() + 1);
+    for (int i = 0; i < edges.size(); i++)
+    {
+        offsets[edgeRow1[i] + 1]++;
+        if (edgeRow2[i] != -1)
+            offsets[edgeRow2[i] + 1]++;
+    }
+    for (int r = 0; r < rowVertex.size(); r++)
+    {
+        offsets[r + 1] += offsets[r];
+    }
+
+    adjacency.resize(offsets.last());
+    QVector<int> next = offsets;
+    for (int i = 0; i < edges.size(); i++)
+    {
+        adjacency[next[edgeRow1[i]]++] = i;
+        if (edgeRow2[i] != -1)
+            adjacency[next[edgeRow2[i]]++] = i;
+    }
+
+    // Neighbours::insertNeighbour puts each edge before the first one with a
+    // smaller angle, which is a stable sort by decreasing angle
+    QVector<QPair<qreal,int>> row;
+    for (int r = 0; r < rowVertex.size(); r++)
+    {
+        int start = offsets[r];
+        int end   = offsets[r + 1];
+        if (end - start < 2)
+            continue;
+
+        row.clear();
+        for (int k = start; k < end; k++)
+        {
+            row.push_back(qMakePair(rowVertex[r]->getAngle(edges[adjacency[k]]),adjacency[k]));
+        }
+        std::stable_sort(row.begin(),row.end(),[](const QPair<qreal,int> & a, const QPair<qreal,int> & b)
+                         { return a.first > b.first; });
+        for (int k = start; k < end; k++)
+        {
+            adjacency[k] = row[k - start].second;
+        }
+    }
+
+    edgeRefs.reserve(edges.size());
+    for (const auto & e : std::as_const(edges))
+    {
+        edgeRefs.push_back(e);
     }
-}
-NeighboursPtr  NeighbourMap::getNeighbours(const VertexPtr & v)
-{
-    return getRawNeighbours(v);
 }
 
-NeighboursPtr  NeighbourMap::getRawNeighbours(const VertexPtr & v)
+// Makes the vertex's Neighbours from its row
+NeighboursPtr NeighbourMap::getNeighbours(const VertexPtr & v) const
 {
-    NeighboursPtr np = nmap.value(v);
-    if (!np)
+    NeighboursPtr np = std::make_shared<Neighbours>(v);
+
+    auto it = rows.constFind(v.get());
+    if (it != rows.constEnd())
     {
-        np = std::make_shared<Neighbours>(v);
-        nmap.insert(v,np);
+        int r = it.value();
+        np->reserve(offsets[r + 1] - offsets[r]);
+        for (int k = offsets[r]; k < offsets[r + 1]; k++)
+        {
+            np->push_back(edgeRefs[adjacency[k]]);
+        }
     }
     return np;
 }
 
-uint NeighbourMap::rawSize()
+int NeighbourMap::numNeighbours(const VertexPtr & v) const
 {
-    uint ncount = 0;
+    int r = row(v);
+    return (r == -1) ? 0 : rowSize(r);
+}
 
-    QMapIterator<VertexPtr, NeighboursPtr> i(nmap);
-    while (i.hasNext())
-    {
-        i.next();
-        auto neighbours = i.value();
-        ncount += neighbours->numNeighbours();
-    }
-    return ncount;
+int NeighbourMap::row(const VertexPtr & v) const
+{
+    return rows.value(v.get(),-1);
 }
 
 void NeighbourMap::examine()
 {
-    QMapIterator<VertexPtr, NeighboursPtr> i(nmap);
-    while (i.hasNext())
+    for (int r = 0; r < offsets.size() - 1; r++)
     {
-        i.next();
-        auto neighbours = i.value();
-        uint ncount = neighbours->numNeighbours();
+        uint ncount = offsets[r + 1] - offsets[r];
         qDebug() << "NeighbourMap::examine() ncouont =" << ncount;
     }
 }
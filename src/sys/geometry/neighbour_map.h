@@ -2,12 +2,26 @@
 #ifndef NEIGHBOURMAP_H
 #define NEIGHBOURMAP_H
 
+////////////////////////////////////////////////////////////////////////////
+//
+// The edges around each vertex of a map, sorted by angle.
+//
+// This is a compressed sparse row table: the vertices are rows, and row
+// r's edges are adjacency[offsets[r]] .. adjacency[offsets[r+1]-1], held
+// as indices into the map's edge list.  The order within a row is the one
+// Neighbours::insertNeighbour() gives, so the Neighbours handed out are
+// the same as when they were built one edge at a time.
+//
+// Maps cache their table, see MapBase::getNeighbourMap(), so it is only
+// rebuilt when the map has changed.
+
+#include <QHash>
 #include <QVector>
-#include <QMap>
 
 #include "sys/geometry/map.h"
 
 typedef std::shared_ptr<class Edge>         EdgePtr;
+typedef std::weak_ptr<class Edge>           WeakEdgePtr;
 typedef QVector<EdgePtr>                    EdgeSet;
 typedef std::shared_ptr<class Vertex>       VertexPtr;
 typedef std::shared_ptr<class Neighbours>   NeighboursPtr;
@@ -18,18 +32,27 @@ public:
     NeighbourMap(MapBase * map);
     NeighbourMap(MapPtr map);
 
-    NeighboursPtr getNeighbours(const VertexPtr & v);
+    NeighboursPtr getNeighbours(const VertexPtr & v) const;
+    int           numNeighbours(const VertexPtr & v) const;
+
+    // direct access, without making a Neighbours
+    int           row(const VertexPtr & v) const;   // -1 if the vertex has no edges
+    int           rowSize(int row) const            { return offsets[row + 1] - offsets[row]; }
+    EdgePtr       rowEdge(int row, int i) const     { return edgeRefs[adjacency[offsets[row] + i]].lock(); }
     void          dumpNeighbours(const VertexPtr & v, const EdgePtr edge);
 
-    uint          rawSize();
+    uint          rawSize() const   { return (uint)adjacency.size(); }
     void          examine();
 
 protected:
-    NeighboursPtr  getRawNeighbours(const VertexPtr & v);
+    void          build();
 
 private:
-    QMap<VertexPtr,NeighboursPtr>   nmap;
-    MapBase *                       map;
+    QHash<const Vertex*,int>    rows;
+    QVector<int>                offsets;    // rows + 1
+    QVector<int>                adjacency;  // edge indices, by angle within a row
+    QVector<WeakEdgePtr>        edgeRefs;   // the map's edges when built
+    MapBase *                   map;
 };
 
 #endif // NEIGHBOURMAP_H
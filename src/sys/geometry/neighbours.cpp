@@ -4,7 +4,7 @@
 #include "sys/geometry/neighbours.h"
 #include "sys/geometry/vertex.h"
 
-int Neighbours::refs = 0;
+std::atomic<int> Neighbours::refs = 0;
 
 extern double angleBetween(EdgePtr a, EdgePtr b);
 
@@ -2,6 +2,7 @@
 #ifndef NEIGHBOURS_H
 #define NEIGHBOURS_H
 
+#include <atomic>
 #include <QMap>
 #include <QVector>
 
@@ -45,7 +46,7 @@ public:
     QString         info(MapPtr &  map);
     QString         casingInfo();
 
-    static int      refs;
+    static std::atomic<int> refs;
 
 protected:
     bool contains(const EdgePtr & e) const;
@@ -12,7 +12,7 @@
 #include "sys/geometry/edge.h"
 #include "sys/geometry/geo.h"
 
-int Vertex::refs = 0;
+std::atomic<int> Vertex::refs = 0;
 
 Vertex::Vertex(const QPointF &pos )
 {
@@ -10,6 +10,7 @@
 // component, a list of adjacent edges.  It also has the planar component,
 // a position.  Finally, there's a user data field for applications.
 
+#include <atomic>
 #include <QPointF>
 #include <QVector>
 #include <QTransform>
@@ -37,7 +38,7 @@ public:
 
     QVector<WeakVertexPtr> adjacent_vertices;  //used by DCEL
 
-    static int  refs;
+    static std::atomic<int> refs;
 };
 
 #endif
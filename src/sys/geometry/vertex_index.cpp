@@ -0,0 +1,132 @@
+#include <QtMath>
+#include "sys/geometry/vertex_index.h"
+#include "sys/geometry/geo.h"
+#include "sys/geometry/vertex.h"
+#include "sys/sys.h"
+
+VertexIndex::VertexIndex()
+{
+    cellSize = qSqrt(Sys::TOL);     // matches Geo::dist2(a,b) < Sys::TOL
+    nextSeq  = 0;
+    depth    = 0;
+}
+
+void VertexIndex::activate(const QVector<VertexPtr> & vertices)
+{
+    if (depth++ == 0)
+    {
+        rebuild(vertices);
+    }
+}
+
+void VertexIndex::deactivate()
+{
+    Q_ASSERT(depth > 0);
+    if (--depth == 0)
+    {
+        clear();
+    }
+}
+
+void VertexIndex::rebuild(const QVector<VertexPtr> & vertices)
+{
+    clear();
+    cells.reserve(vertices.size());
+    cellOf.reserve(vertices.size());
+    for (const auto & v : std::as_const(vertices))
+    {
+        insert(v);
+    }
+}
+
+void VertexIndex::clear()
+{
+    cells.clear();
+    cellOf.clear();
+    nextSeq = 0;
+}
+
+void VertexIndex::insert(const VertexPtr & v)
+{
+    if (cellOf.contains(v.get()))
+    {
+        return;     // the vertex list is unique too
+    }
+
+    CellKey key = cellKey(v->pt);
+    IndexedVertex iv;
+    iv.v   = v;
+    iv.seq = nextSeq++;
+    cells[key].push_back(iv);
+    cellOf.insert(v.get(),key);
+}
+
+void VertexIndex::remove(const VertexPtr & v)
+{
+    auto it = cellOf.find(v.get());
+    if (it == cellOf.end())
+    {
+        return;
+    }
+
+    auto cit = cells.find(it.value());
+    if (cit != cells.end())
+    {
+        QVector<IndexedVertex> & cell = cit.value();
+        for (int i = 0; i < cell.size(); i++)
+        {
+            if (cell[i].v == v)
+            {
+                cell.remove(i);
+                break;
+            }
+        }
+        if (cell.isEmpty())
+        {
+            cells.erase(cit);
+        }
+    }
+    cellOf.erase(it);
+}
+
+// Returns the earliest inserted vertex within tolerance of pt, or null
+VertexPtr VertexIndex::find(const QPointF & pt) const
+{
+    CellKey key = cellKey(pt);
+
+    const IndexedVertex * best = nullptr;
+    for (qint64 x = key.first - 1; x <= key.first + 1; x++)
+    {
+        for (qint64 y = key.second - 1; y <= key.second + 1; y++)
+        {
+            auto cit = cells.constFind(CellKey(x,y));
+            if (cit == cells.constEnd())
+            {
+                continue;
+            }
+            for (const IndexedVertex & iv : std::as_const(cit.value()))
+            {
+                if (Geo::dist2(pt,iv.v->pt) < Sys::TOL)
+                {
+                    if (!best || iv.seq < best->seq)
+                    {
+                        best = &iv;
+                    }
+                }
+            }
+        }
+    }
+
+    if (best)
+    {
+        return best->v;
+    }
+    VertexPtr vp;
+    return vp;
+}
+
+VertexIndex::CellKey VertexIndex::cellKey(const QPointF & pt) const
+{
+    return CellKey(static_cast<qint64>(std::floor(pt.x() / cellSize)),
+                   static_cast<qint64>(std::floor(pt.y() / cellSize)));
+}
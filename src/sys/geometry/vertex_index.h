@@ -0,0 +1,65 @@
+#pragma once
+#ifndef VERTEX_INDEX_H
+#define VERTEX_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// A tolerance-aware spatial hash over the vertices of a map.
+//
+// Points are bucketed into square cells whose side is the vertex matching
+// distance, sqrt(Sys::TOL), so any match for a point lies in the 3x3 block
+// of cells around it.  Each entry carries an insertion sequence number so
+// that, when more than one vertex matches, the one which comes first in the
+// map's vertex list wins - exactly as the linear scan did.
+//
+// The index is only trusted while it is active.  Vertices can be moved from
+// outside the map (editors, shared vertices in copied maps) so the index is
+// activated for the duration of bulk operations such as merges, and then
+// discarded.  Activations nest.
+
+#include <QHash>
+#include <QPair>
+#include <QPointF>
+#include <QVector>
+
+typedef std::shared_ptr<class Vertex>   VertexPtr;
+
+class VertexIndex
+{
+public:
+    VertexIndex();
+
+    void        activate(const QVector<VertexPtr> & vertices);
+    void        deactivate();
+    bool        isActive() const    { return (depth > 0); }
+    void        rebuild(const QVector<VertexPtr> & vertices);
+    void        clear();
+
+    void        insert(const VertexPtr & v);
+    void        remove(const VertexPtr & v);
+    VertexPtr   find(const QPointF & pt) const;
+
+    int         size() const        { return cellOf.size(); }
+
+protected:
+    typedef QPair<qint64,qint64> CellKey;
+
+    class IndexedVertex
+    {
+    public:
+        VertexPtr   v;
+        quint64     seq;
+    };
+
+    CellKey     cellKey(const QPointF & pt) const;
+
+private:
+    QHash<CellKey,QVector<IndexedVertex>>   cells;
+    QHash<const Vertex*,CellKey>            cellOf;
+
+    qreal       cellSize;
+    quint64     nextSeq;
+    int         depth;
+};
+
+#endif
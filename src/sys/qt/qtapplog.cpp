@@ -4,6 +4,7 @@
 #include <QApplication>
 #include <QDir>
 #include <QTextStream>
+#include <QThread>
 
 #if defined(Q_OS_WINDOWS)
 #include <Windows.h>
@@ -327,7 +328,8 @@ void qtAppLog::crashMessageOutput(QtMsgType type, const QMessageLogContext &cont
     }
 
     msg2 += "\n";
-    if (_logToPanel && !_trapping)
+    // the panel is a widget, so messages from worker threads only go to stderr and disk
+    if (_logToPanel && !_trapping && QThread::currentThread() == ted->thread())
     {
         switch (type)
         {
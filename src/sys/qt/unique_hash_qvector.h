@@ -0,0 +1,164 @@
+#pragma once
+#ifndef UNIQUE_HASH_QVECTOR_H
+#define UNIQUE_HASH_QVECTOR_H
+
+#include <QVector>
+#include <atomic>
+#include <unordered_set>
+
+// An ordered vector of unique values, like UniqueQVector, but with a side
+// hash set so that push_back() and contains() do not scan the vector.
+// Insertion order, indexOf() and read access are those of the QVector.
+// The contents must only be changed through the members declared here,
+// otherwise the hash set falls out of step with the vector.
+// T needs a std::hash specialisation (shared pointers and enums have one).
+// revision() changes whenever the contents do, so that derived tables can
+// tell when they are stale.  Revisions are drawn from one process-wide
+// counter, so they only ever increase, including across assignments.
+
+inline quint64 nextContentRevision()
+{
+    static std::atomic<quint64> counter(0);
+    return ++counter;
+}
+
+template <class T> class UniqueHashQVector : public QVector<T>
+{
+public:
+    UniqueHashQVector();
+    UniqueHashQVector(const QVector<T> & other);
+    UniqueHashQVector(const UniqueHashQVector & other);
+
+    UniqueHashQVector & operator=(const QVector<T> & other);
+    UniqueHashQVector & operator=(const UniqueHashQVector & other);
+
+    void push_back(const T & value);
+    void push_front(const T & value);
+    void append(const T & value)           { push_back(value); }
+    void append(const QVector<T> & other);
+    void prepend(const T & value)          { push_front(value); }
+
+    bool      contains(const T & value) const { return members.find(value) != members.end(); }
+    bool      removeOne(const T & value);
+    qsizetype removeAll(const T & value)      { return removeOne(value) ? 1 : 0; }
+    void      removeAt(qsizetype i);
+    qsizetype removeMany(const QVector<T> & values);   // one pass over the vector
+    void      clear();
+    void      reserve(qsizetype size);
+
+    quint64   revision() const                { return rev; }
+
+private:
+    void      bump()                          { rev = nextContentRevision(); }
+
+    std::unordered_set<T> members;
+    quint64               rev = 0;
+};
+
+template <class T> UniqueHashQVector<T>::UniqueHashQVector() : QVector<T>()
+{}
+
+template <class T> UniqueHashQVector<T>::UniqueHashQVector(const QVector<T> & other) : QVector<T>()
+{
+    append(other);
+}
+
+template <class T> UniqueHashQVector<T>::UniqueHashQVector(const UniqueHashQVector & other) : QVector<T>(other), members(other.members)
+{
+    bump();
+}
+
+template <class T> UniqueHashQVector<T> & UniqueHashQVector<T>::operator=(const QVector<T> & other)
+{
+    clear();
+    append(other);
+    return *this;
+}
+
+template <class T> UniqueHashQVector<T> & UniqueHashQVector<T>::operator=(const UniqueHashQVector & other)
+{
+    if (this != &other)
+    {
+        QVector<T>::operator=(other);
+        members = other.members;
+    }
+    bump();
+    return *this;
+}
+
+template <class T> void UniqueHashQVector<T>::push_back(const T & value)
+{
+    if (members.insert(value).second)
+    {
+        QVector<T>::push_back(value);
+        bump();
+    }
+}
+
+template <class T> void UniqueHashQVector<T>::push_front(const T & value)
+{
+    if (members.insert(value).second)
+    {
+        QVector<T>::push_front(value);
+        bump();
+    }
+}
+
+template <class T> void UniqueHashQVector<T>::append(const QVector<T> & other)
+{
+    reserve(QVector<T>::size() + other.size());
+    for (const auto & t : other)
+    {
+        push_back(t);
+    }
+}
+
+template <class T> bool UniqueHashQVector<T>::removeOne(const T & value)
+{
+    if (members.erase(value) == 0)
+    {
+        return false;
+    }
+    bump();
+    return QVector<T>::removeOne(value);
+}
+
+template <class T> void UniqueHashQVector<T>::removeAt(qsizetype i)
+{
+    members.erase(QVector<T>::at(i));
+    QVector<T>::removeAt(i);
+    bump();
+}
+
+template <class T> qsizetype UniqueHashQVector<T>::removeMany(const QVector<T> & values)
+{
+    std::unordered_set<T> doomed;
+    for (const auto & value : values)
+    {
+        if (members.erase(value))
+        {
+            doomed.insert(value);
+        }
+    }
+    if (doomed.empty())
+    {
+        return 0;
+    }
+    bump();
+    return QVector<T>::removeIf([&doomed](const T & t) { return doomed.count(t) > 0; });
+}
+
+template <class T> void UniqueHashQVector<T>::clear()
+{
+    members.clear();
+    QVector<T>::clear();
+    bump();
+}
+
+template <class T> void UniqueHashQVector<T>::reserve(qsizetype size)
+{
+    members.reserve(size);
+    QVector<T>::reserve(size);
+}
+
+#endif
@@ -27,8 +27,10 @@
 #include "sys/geometry/dcel.h"
 #include "sys/geometry/debug_map.h"
 #include "sys/geometry/edge.h"
+#include "sys/geometry/map_arena.h"
 #include "sys/geometry/vertex.h"
-#include "sys/debugflags.h"
+#include "sys/sys/debugflags.h"
+#include "sys/sys/invalidator.h"
 #include "sys/sys.h"
 #include "sys/version.h"
 
@@ -51,6 +53,7 @@ SplashScreen    * Sys::splash           = nullptr;
 DebugMap        * Sys::debugMapCreate   = nullptr;
 DebugMap        * Sys::debugMapPaint    = nullptr;
 DebugFlags      * Sys::flags            = nullptr;
+Invalidator     * Sys::invalidator      = nullptr;
 
 // makers
 DesignMaker    * Sys::designMaker       = nullptr;
@@ -183,6 +186,7 @@ Sys::Sys()
     debugMapCreate      = new DebugMap;
     debugMapPaint       = new DebugMap;
     flags               = new DebugFlags;
+    invalidator         = new Invalidator;
 
     sysBMPDir           = createBMPDirectory();
 
@@ -239,6 +243,9 @@ Sys::~Sys()
     delete mosaicMaker;
     mosaicMaker = nullptr;
 
+    delete invalidator;
+    invalidator = nullptr;
+
     dumpRefs();
 }
 
@@ -257,27 +264,21 @@ void Sys::appDebugBreak()
 #endif
 }
 
-void Sys::render(eRenderType rtype)
+// Marks the node and everything downstream of it dirty.  The dirty derived
+// data is reset, and the view rebuilt, once control returns to the event loop
+void Sys::invalidate(eInvalidNode node)
 {
-    switch (rtype)
-    {
-    case RENDER_RESET_MOTIFS:
-        prototypeMaker->sm_resetMotifMaps();
-        prototypeMaker->sm_resetProtoMaps();
-        mosaicMaker->sm_resetStyles();
-        break;
-
-    case RENDER_RESET_PROTOTYPES:
-        prototypeMaker->sm_resetProtoMaps();
-        mosaicMaker->sm_resetStyles();
-        break;
+    invalidator->invalidate(node);
+}
 
-    case RENDER_RESET_STYLES:
-        mosaicMaker->sm_resetStyles();
-        break;
-    }
+void Sys::invalidate(eInvalidNode node, ProtoPtr proto)
+{
+    invalidator->invalidate(node,proto);
+}
 
-    viewController->slot_reconstructView();
+void Sys::invalidate(std::shared_ptr<class Style> style)
+{
+    invalidator->invalidate(style);
 }
 
 bool Sys::isGuiThread()
@@ -524,14 +525,15 @@ void Sys::dumpRefs()
     qDebug() << "Mosaics:"  << Mosaic::refs
              << "Styles:"   << Style::refs
              << "Protos:"   << Prototype::refs
-             << "Maps:"     << Map::refs
+             << "Maps:"     << Map::refs.load()
              << "DCELs:"    << DCEL::refs
              << "Faces:"    << Face::refs
              << "DELs:"     << DesignElement::refs
              << "Motifs:"   << Motif::refs
              << "Tilings:"  << Tiling::refs
-             << "Tiles:"    << Tile::refs
-             << "Edges:"    << Edge::refs
-             << "Vertices:" << Vertex::refs
-             << "Neighbours:" << Neighbours::refs;
+             << "Tiles:"    << Tile::refs.load()
+             << "Edges:"    << Edge::refs.load()
+             << "Vertices:" << Vertex::refs.load()
+             << "Neighbours:" << Neighbours::refs.load()
+             << "Arenas:"   << MapArena::refs.load();
 }
@@ -7,7 +7,7 @@
 #include "sys/enums/ecyclemode.h"
 #include "sys/enums/emotiftype.h"
 #include "sys/enums/emousemode.h"
-#include "sys/enums/erender.h"
+#include "sys/enums/einvalidate.h"
 #include "sys/sys/versioning.h"
 
 #undef LEGACY_CONVERT_XML
@@ -34,7 +34,9 @@ public:
     ~Sys();
 
     static void         appDebugBreak();
-    static void         render(eRenderType rtype);
+    static void         invalidate(eInvalidNode node);
+    static void         invalidate(eInvalidNode node, std::shared_ptr<class Prototype> proto);
+    static void         invalidate(std::shared_ptr<class Style> style);
 
     static void         setSysMouseMode(eMouseMode newMode, bool set);
     static bool         getSysMouseMode(eMouseMode mode);
@@ -95,6 +97,7 @@ public:
     static class DebugMap   * debugMapCreate;
     static class DebugMap   * debugMapPaint;
     static class DebugFlags * flags;
+    static class Invalidator * invalidator;
 
     static bool   isDarkTheme;
     static bool   imgGeneratorInUse;
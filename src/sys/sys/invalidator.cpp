@@ -0,0 +1,233 @@
+#include <QDebug>
+#include <QTimer>
+
+#include "sys/sys/invalidator.h"
+#include "gui/top/system_view_controller.h"
+#include "model/borders/border.h"
+#include "model/makers/mosaic_maker.h"
+#include "model/makers/prototype_maker.h"
+#include "model/mosaics/mosaic.h"
+#include "model/motifs/motif.h"
+#include "model/prototypes/design_element.h"
+#include "model/prototypes/prototype.h"
+#include "model/styles/style.h"
+#include "sys/sys.h"
+
+Invalidator::Invalidator()
+{
+    clear();
+
+    flushTimer = new QTimer;
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(0);
+    QObject::connect(flushTimer, &QTimer::timeout, flushTimer, [this] { flush(); });
+}
+
+Invalidator::~Invalidator()
+{
+    delete flushTimer;
+}
+
+// weak pointers have no ==, so compare what they point at
+template <class T> static void addOnce(QVector<std::weak_ptr<T>> & list, const std::shared_ptr<T> & item)
+{
+    for (const auto & witem : std::as_const(list))
+    {
+        if (witem.lock() == item)
+            return;
+    }
+    list.push_back(item);
+}
+
+QVector<eInvalidNode> Invalidator::dependents(eInvalidNode node)
+{
+    QVector<eInvalidNode> deps;
+    switch (node)
+    {
+    case INV_TILING:
+        deps << INV_MOTIF;
+        break;
+    case INV_MOTIF:
+    case INV_CROP:
+        deps << INV_PROTOTYPE;
+        break;
+    case INV_PROTOTYPE:
+        deps << INV_STYLE;
+        break;
+    case INV_STYLE:
+    case INV_BORDER:
+    case INV_CANVAS:
+    case NUM_INV_NODES:
+        break;
+    }
+    return deps;
+}
+
+void Invalidator::invalidate(eInvalidNode node)
+{
+    qDebug().noquote() << "Invalidate" << sInvalidNode[node];
+    mark(node);
+    schedule();
+}
+
+void Invalidator::invalidate(eInvalidNode node, const ProtoPtr & proto)
+{
+    if (!proto)
+    {
+        invalidate(node);
+        return;
+    }
+    qDebug().noquote() << "Invalidate" << sInvalidNode[node] << "for prototype" << proto.get();
+    mark(node,proto);
+    schedule();
+}
+
+void Invalidator::invalidate(const StylePtr & style)
+{
+    if (!style)
+    {
+        invalidate(INV_STYLE);
+        return;
+    }
+    addOnce(dirtyStyles,style);
+    schedule();
+}
+
+// one flush per pass of the event loop, however many invalidations
+void Invalidator::schedule()
+{
+    if (!flushTimer->isActive())
+    {
+        flushTimer->start();
+    }
+}
+
+bool Invalidator::isPending() const
+{
+    return flushTimer->isActive();
+}
+
+void Invalidator::mark(eInvalidNode node)
+{
+    if (dirtyAll[node])
+        return;
+    dirtyAll[node] = true;
+    for (auto dep : dependents(node))
+    {
+        mark(dep);
+    }
+}
+
+void Invalidator::mark(eInvalidNode node, const ProtoPtr & proto)
+{
+    addOnce(dirtyProtos[node],proto);
+    for (auto dep : dependents(node))
+    {
+        mark(dep,proto);
+    }
+}
+
+bool Invalidator::isDirty(eInvalidNode node) const
+{
+    return dirtyAll[node] || !dirtyProtos[node].isEmpty();
+}
+
+// Resets the dirty derived data, upstream first, then rebuilds the view
+void Invalidator::flush()
+{
+    flushTimer->stop();
+
+    auto mosaic = Sys::mosaicMaker->getMosaic();
+
+    if (dirtyAll[INV_MOTIF])
+    {
+        Sys::prototypeMaker->sm_resetMotifMaps();
+    }
+    else
+    {
+        for (const auto & wproto : std::as_const(dirtyProtos[INV_MOTIF]))
+        {
+            auto proto = wproto.lock();
+            if (!proto) continue;
+            for (const auto & del : proto->getDesignElements())
+            {
+                del->getMotif()->resetMotifMap();
+            }
+        }
+    }
+
+    if (dirtyAll[INV_PROTOTYPE])
+    {
+        Sys::prototypeMaker->sm_resetProtoMaps();
+    }
+    else
+    {
+        for (const auto & wproto : std::as_const(dirtyProtos[INV_PROTOTYPE]))
+        {
+            auto proto = wproto.lock();
+            if (proto) proto->wipeoutProtoMap();
+        }
+    }
+
+    if (dirtyAll[INV_STYLE])
+    {
+        Sys::mosaicMaker->sm_resetStyles();
+    }
+    else if (mosaic)
+    {
+        for (const auto & wproto : std::as_const(dirtyProtos[INV_STYLE]))
+        {
+            auto proto = wproto.lock();
+            if (proto) mosaic->resetStyleMaps(proto);
+        }
+    }
+
+    if (isDirty(INV_BORDER) && mosaic)
+    {
+        auto border = mosaic->getBorder();
+        if (border)
+        {
+            border->resetStyleRepresentation();
+        }
+    }
+
+    // styles whose own settings changed are recreated in place
+    if (!dirtyAll[INV_STYLE])
+    {
+        for (const auto & wstyle : std::as_const(dirtyStyles))
+        {
+            auto style = wstyle.lock();
+            if (!style) continue;
+            style->resetStyleRepresentation();
+            style->createStyleRepresentation();
+        }
+    }
+
+    bool changed = false;
+    for (int i = 0; i < NUM_INV_NODES; i++)
+    {
+        if (isDirty(static_cast<eInvalidNode>(i)))
+            changed = true;
+    }
+    bool restyled = !dirtyStyles.isEmpty();
+    clear();
+
+    if (changed)
+    {
+        Sys::viewController->slot_reconstructView();
+    }
+    else if (restyled)
+    {
+        Sys::viewController->slot_updateView();
+    }
+}
+
+void Invalidator::clear()
+{
+    for (int i = 0; i < NUM_INV_NODES; i++)
+    {
+        dirtyAll[i] = false;
+        dirtyProtos[i].clear();
+    }
+    dirtyStyles.clear();
+}
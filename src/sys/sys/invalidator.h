@@ -0,0 +1,65 @@
+#pragma once
+#ifndef INVALIDATOR_H
+#define INVALIDATOR_H
+
+////////////////////////////////////////////////////////////////////////////
+//
+// The invalidation graph.
+//
+// Tiling, Motif, Prototype, Crop, Style, Border and Canvas are nodes with
+// dirty bits.  Invalidating a node marks it and everything downstream of
+// it, either everywhere or for one prototype only.  A single style can be
+// invalidated too, for colour and width edits.
+//
+// Nothing is reset when a node is invalidated.  The first invalidation
+// queues a flush for when control returns to the event loop, so a burst of
+// edits, such as a spin box drag, is coalesced into one flush.
+// flush() resets just the derived data which is dirty, and then recreates
+// the view: a style-only change recreates the dirty styles and repaints,
+// anything else reconstructs the view.  Callers which need the reset done
+// at once can call flush() themselves.
+//
+//     Tiling --> Motif --> Prototype --> Style
+//                Crop  ----^
+//     Border, Canvas (view only)
+
+#include <QVector>
+#include "sys/enums/einvalidate.h"
+
+class QTimer;
+
+typedef std::shared_ptr<class Prototype>    ProtoPtr;
+typedef std::weak_ptr<class Prototype>      WeakProtoPtr;
+typedef std::shared_ptr<class Style>        StylePtr;
+typedef std::weak_ptr<class Style>          WeakStylePtr;
+
+class Invalidator
+{
+public:
+    Invalidator();
+    ~Invalidator();
+
+    void    invalidate(eInvalidNode node);                          // everywhere
+    void    invalidate(eInvalidNode node, const ProtoPtr & proto);  // one prototype
+    void    invalidate(const StylePtr & style);                     // one style
+    void    flush();
+
+    bool    isDirty(eInvalidNode node) const;
+    bool    isPending() const;
+
+    static QVector<eInvalidNode> dependents(eInvalidNode node);
+
+protected:
+    void    mark(eInvalidNode node);
+    void    mark(eInvalidNode node, const ProtoPtr & proto);
+    void    schedule();
+    void    clear();
+
+private:
+    bool                    dirtyAll[NUM_INV_NODES];
+    QVector<WeakProtoPtr>   dirtyProtos[NUM_INV_NODES];
+    QVector<WeakStylePtr>   dirtyStyles;
+    QTimer *                flushTimer;
+};
+
+#endif